@@ -0,0 +1,134 @@
+/**
+ * @file TroopTargetingBench.cpp
+ * @brief Measures how troop movement scales with entity count
+ *
+ * For each size N the benchmark places N enemies and N troops at random
+ * positions and reports:
+ * - the cost of one full World tick
+ * - the cost of finding every troop's next step, three ways: through the
+ *   enemy distance field (one search, then a lookup per troop; troops the
+ *   search does not reach query the spatial hash, as in the game), through
+ *   one spatial hash nearest-enemy query per troop, and through the old
+ *   all-pairs scan
+ *
+ * The field costs one bounded search however many troops there are; the
+ * per-troop queries grow with N, the scan quadratically.
+ */
+
+#include "World.h"
+#include "SpatialHash.h"
+#include "EnemyField.h"
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <random>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+namespace {
+
+const int TICKS_PER_ROUND = 5;
+const int ROUNDS = 20;
+
+void populate(World& world, int count, mt19937& gen) {
+    Board& board = world.getBoard();
+    uniform_int_distribution<> xDis(board.getMargin() + 1, board.getWidth() - 2);
+    uniform_int_distribution<> yDis(1, board.getHeight() - 2);
+
+    for (int i = 0; i < count; ++i) {
+        int x = xDis(gen);
+        int y = yDis(gen);
+        board.addUnit(i % 2 ? UnitKind::RAIDER : UnitKind::BOMBERMAN, x, y);
+        x = xDis(gen);
+        y = yDis(gen);
+        board.addUnit(i % 2 ? UnitKind::ARCHER : UnitKind::BARBARIAN, x, y);
+    }
+}
+
+double tickNs(int count) {
+    mt19937 gen(1234);
+    double total = 0;
+    for (int round = 0; round < ROUNDS; ++round) {
+        World world;
+        populate(world, count, gen);
+        auto start = Clock::now();
+        world.step(TICKS_PER_ROUND);
+        total += chrono::duration<double, nano>(Clock::now() - start).count();
+    }
+    return total / (ROUNDS * TICKS_PER_ROUND);
+}
+
+// Movement queries only: the nearest enemy of every troop
+void queryNs(int count, double& fieldNs, double& hashedNs, double& bruteNs) {
+    mt19937 gen(99);
+    World world;
+    const Board& board = world.getBoard();
+    uniform_int_distribution<> xDis(board.getMargin() + 1, board.getWidth() - 2);
+    uniform_int_distribution<> yDis(1, board.getHeight() - 2);
+    vector<Position> enemies, troops;
+    for (int i = 0; i < count; ++i) {
+        enemies.emplace_back(xDis(gen), yDis(gen));
+        troops.emplace_back(xDis(gen), yDis(gen));
+    }
+
+    long checksum = 0;
+    SpatialHash index(board.getWidth(), board.getHeight());
+    OccupancyGrid grid(board.getWidth(), board.getHeight());
+    EnemyField field(board.getWidth(), board.getHeight(), board.getMargin() + 1, 1,
+                     board.getWidth() - 2, board.getHeight() - 2);
+    vector<pair<int, int>> nearest;
+    auto start = Clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        index.rebuild(enemies);
+        field.build(enemies, troops, grid);
+        for (size_t t = 0; t < troops.size(); ++t) {
+            if (field.reached(troops[t])) {
+                checksum += field.nextStep(troops[t]).x;
+                continue;
+            }
+            index.kNearest(troops[t], 1, nearest);
+            checksum += nearest.empty() ? 0 : nearest.front().first;
+        }
+    }
+    fieldNs = chrono::duration<double, nano>(Clock::now() - start).count() / ROUNDS;
+
+    start = Clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        index.rebuild(enemies);
+        for (size_t t = 0; t < troops.size(); ++t) {
+            index.kNearest(troops[t], 1, nearest);
+            checksum += nearest.empty() ? 0 : nearest.front().first;
+        }
+    }
+    hashedNs = chrono::duration<double, nano>(Clock::now() - start).count() / ROUNDS;
+
+    start = Clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        for (size_t t = 0; t < troops.size(); ++t) {
+            int closest = INT_MAX;
+            for (size_t e = 0; e < enemies.size(); ++e) {
+                int d = abs(troops[t].x - enemies[e].x) + abs(troops[t].y - enemies[e].y);
+                if (d < closest) closest = d;
+            }
+            checksum += closest;
+        }
+    }
+    bruteNs = chrono::duration<double, nano>(Clock::now() - start).count() / ROUNDS;
+
+    if (checksum == 42) printf(" ");  // Keep the loops from being optimized away
+}
+
+}
+
+int main() {
+    printf("%8s %14s %14s %16s %16s %16s\n", "N", "tick ns", "tick ns/ent", "field move ns", "hash move ns",
+           "scan move ns");
+    for (int count : { 50, 100, 200, 400, 800, 1600 }) {
+        double tick = tickNs(count);
+        double field, hashed, brute;
+        queryNs(count, field, hashed, brute);
+        printf("%8d %14.0f %14.1f %16.0f %16.0f %16.0f\n", count, tick, tick / (2.0 * count), field, hashed, brute);
+    }
+    return 0;
+}
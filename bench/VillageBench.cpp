@@ -0,0 +1,309 @@
+/**
+ * @file VillageBench.cpp
+ * @brief Per-phase tick, placement and render costs for canned scenarios
+ *
+ * Each scenario sets up a World with N enemies, M walls and K troops on
+ * either an open map or with the walls ringed around the Town Hall, then
+ * runs a fixed number of ticks and reports:
+ * - ns per tick, total and per Board::update() phase (from the Profiler;
+ *   zero when built with VILLAGE_PROFILING=OFF)
+ * - ns per CanBuild() query for a gold mine footprint
+ * - ns and bytes per rendered frame (differential output, not written)
+ * - global heap allocations per tick
+ *
+ * Run without arguments for the canned matrix, or describe one scenario:
+ *   village_bench --enemies=N --walls=M --troops=K --layout=open|walled
+ *                 [--ticks=T] [--rounds=R] [--threads=W] [--map=WxH]
+ *                 [--waves=classic|siege|<file>]
+ *
+ * --map runs every scenario on a larger map; units are then placed
+ * around the Town Hall, so the active area stays the same. Frames are
+ * rendered through a default-sized viewport. The flow fields are built
+ * before the timed ticks.
+ *
+ * --waves sets the spawn table. Its bulk waves land on single ticks, so
+ * the slowest spawn phase of the run is reported next to the average.
+ */
+
+#include "World.h"
+#include "Distance.h"
+#include "TerminalRenderer.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+// Every global allocation in the process goes through here so the benchmark
+// can report heap calls per tick. The whole set is replaced, so no form
+// pairs malloc() with a library operator; every delete ends in the one that
+// calls free(), kept out of line because GCC warns (-Wmismatched-new-delete)
+// when it inlines free() into a caller that got the memory from operator new.
+static atomic<uint64_t> allocationCount(0);
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const nothrow_t& tag) noexcept { return operator new(size, tag); }
+
+__attribute__((noinline)) void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, size_t) noexcept { operator delete(p); }
+void operator delete(void* p, const nothrow_t&) noexcept { operator delete(p); }
+void operator delete[](void* p, const nothrow_t&) noexcept { operator delete(p); }
+
+namespace {
+
+const Metric PHASES[4] = { Metric::SPAWN_NS, Metric::ENEMIES_NS, Metric::TROOPS_NS, Metric::RESOURCES_NS };
+
+struct Scenario {
+    string name;
+    int enemies;
+    int walls;
+    int troops;
+    bool walledIn;  // Walls ring the Town Hall instead of being scattered
+};
+
+struct Options {
+    int ticks = 50;
+    int rounds = 5;
+    int threads = 0;
+    MapSize map;
+    SpawnTable waves = classicSpawnTable();
+};
+
+struct Result {
+    double tickNs = 0;
+    double phaseNs[4] = {};
+    double worstSpawnNs = 0;
+    double canBuildNs = 0;
+    double renderNs = 0;
+    double frameBytes = 0;
+    double allocsPerTick = 0;
+};
+
+double elapsedNs(Clock::time_point start) {
+    return chrono::duration<double, nano>(Clock::now() - start).count();
+}
+
+// Rings of walls around the Town Hall footprint, innermost first, two cells apart
+void placeWallRings(Board& board, int count) {
+    const TownHall& th = board.getTownHall();
+    int x0 = th.getPosition().x, y0 = th.getPosition().y;
+    int x1 = x0 + th.getSizeX() - 1, y1 = y0 + th.getSizeY() - 1;
+
+    int placed = 0;
+    for (int r = 2; placed < count && r < board.getWidth(); r += 2) {
+        for (int y = y0 - r; y <= y1 + r && placed < count; ++y) {
+            for (int x = x0 - r; x <= x1 + r && placed < count; ++x) {
+                bool onRing = y == y0 - r || y == y1 + r || x == x0 - r || x == x1 + r;
+                if (onRing && board.addWall(x, y)) ++placed;
+            }
+        }
+    }
+}
+
+void setup(World& world, const Scenario& scenario, mt19937& gen) {
+    Board& board = world.getBoard();
+    int minX = board.getMargin() + 1, maxX = board.getWidth() - 2;
+    int minY = 1, maxY = board.getHeight() - 2;
+
+    // On a larger map, use an area of the default play size around the Town Hall
+    const TownHall& th = board.getTownHall();
+    int halfX = (MapSize::DEFAULT_WIDTH - 3 - board.getMargin()) / 2;
+    int halfY = (MapSize::DEFAULT_HEIGHT - 3) / 2;
+    if (maxX - minX > 2 * halfX) {
+        minX = max(minX, th.getPosition().x + th.getSizeX() / 2 - halfX);
+        maxX = minX + 2 * halfX;
+    }
+    if (maxY - minY > 2 * halfY) {
+        minY = max(minY, th.getPosition().y + th.getSizeY() / 2 - halfY);
+        maxY = minY + 2 * halfY;
+    }
+    uniform_int_distribution<> xDis(minX, maxX);
+    uniform_int_distribution<> yDis(minY, maxY);
+
+    if (scenario.walledIn) {
+        placeWallRings(board, scenario.walls);
+    } else {
+        for (int placed = 0, tries = 0; placed < scenario.walls && tries < 100 * scenario.walls; ++tries) {
+            int x = xDis(gen);
+            int y = yDis(gen);
+            if (board.addWall(x, y)) ++placed;
+        }
+    }
+
+    // Enemies start on the left and right edges, troops anywhere
+    for (int i = 0; i < scenario.enemies; ++i) {
+        int y = yDis(gen);
+        board.addUnit(i % 2 ? UnitKind::RAIDER : UnitKind::BOMBERMAN, i % 4 < 2 ? minX : maxX, y);
+    }
+    for (int i = 0; i < scenario.troops; ++i) {
+        int x = xDis(gen);
+        int y = yDis(gen);
+        board.addUnit(i % 2 ? UnitKind::ARCHER : UnitKind::BARBARIAN, x, y);
+    }
+}
+
+double canBuildNs(const Board& board, mt19937& gen) {
+    uniform_int_distribution<> xDis(board.getMargin() + 1, board.getWidth() - 4);
+    uniform_int_distribution<> yDis(1, board.getHeight() - 4);
+    vector<GoldMine> probes;
+    for (int i = 0; i < 1000; ++i) {
+        int x = xDis(gen);
+        int y = yDis(gen);
+        probes.emplace_back(x, y);
+    }
+
+    int free = 0;
+    auto start = Clock::now();
+    for (int pass = 0; pass < 10; ++pass) {
+        for (const auto& probe : probes) free += board.CanBuild(&probe);
+    }
+    double ns = elapsedNs(start) / (10.0 * probes.size());
+    if (free == -1) printf(" ");  // Keep the loop from being optimized away
+    return ns;
+}
+
+Result run(const Scenario& scenario, const Options& options) {
+    Result result;
+    int ticks = 0;
+    int frames = 0;
+    uint64_t allocations = 0;
+
+    for (int round = 0; round < options.rounds; ++round) {
+        mt19937 gen(1000 + round);
+        World world(round + 1, options.threads, options.map, options.waves);
+        setup(world, scenario, gen);
+        Board& board = world.getBoard();
+        board.buildFlowFields();
+
+        TerminalRenderer renderer(min(board.getWidth(), static_cast<int>(MapSize::DEFAULT_WIDTH)),
+                                  min(board.getHeight(), static_cast<int>(MapSize::DEFAULT_HEIGHT)));
+        renderer.getFrameBuffer().setOutputFd(-1);
+        renderer.render(board);  // The first frame is a full redraw; measure steady state
+
+        result.canBuildNs += canBuildNs(board, gen);
+
+        for (int t = 0; t < options.ticks && !world.isGameOver(); ++t) {
+            uint64_t allocationsBefore = allocationCount.load(memory_order_relaxed);
+            auto start = Clock::now();
+            world.step();
+            result.tickNs += elapsedNs(start);
+            allocations += allocationCount.load(memory_order_relaxed) - allocationsBefore;
+            for (int p = 0; p < 4; ++p) {
+                result.phaseNs[p] += Profiler::lastTick(PHASES[p]);
+            }
+            result.worstSpawnNs = max(result.worstSpawnNs, static_cast<double>(Profiler::lastTick(Metric::SPAWN_NS)));
+            ++ticks;
+
+            start = Clock::now();
+            renderer.render(board);
+            result.renderNs += elapsedNs(start);
+            result.frameBytes += renderer.getFrameBuffer().getLastFrameBytes();
+            ++frames;
+        }
+    }
+
+    if (ticks > 0) {
+        result.tickNs /= ticks;
+        for (double& ns : result.phaseNs) ns /= ticks;
+        result.allocsPerTick = static_cast<double>(allocations) / ticks;
+    }
+    if (frames > 0) {
+        result.renderNs /= frames;
+        result.frameBytes /= frames;
+    }
+    result.canBuildNs /= options.rounds;
+    return result;
+}
+
+void printHeader() {
+    printf("%-16s %6s %6s %6s %10s %9s %9s %9s %9s %9s %9s %9s %9s %9s\n",
+           "scenario", "enemy", "walls", "troop", "tick ns", "spawn", "spawn max", "enemies", "troops", "resource",
+           "canBuild", "render ns", "bytes/fr", "allocs/t");
+}
+
+void printRow(const Scenario& scenario, const Result& r) {
+    printf("%-16s %6d %6d %6d %10.0f %9.0f %9.0f %9.0f %9.0f %9.0f %9.1f %9.0f %9.0f %9.2f\n",
+           scenario.name.c_str(), scenario.enemies, scenario.walls, scenario.troops, r.tickNs,
+           r.phaseNs[0], r.worstSpawnNs, r.phaseNs[1], r.phaseNs[2], r.phaseNs[3],
+           r.canBuildNs, r.renderNs, r.frameBytes, r.allocsPerTick);
+}
+
+// Returns the value of "--name=value", or nullptr if arg is a different option
+const char* optionValue(const char* arg, const char* name) {
+    size_t length = strlen(name);
+    if (strncmp(arg, name, length) != 0 || arg[length] != '=') return nullptr;
+    return arg + length + 1;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    Scenario custom{ "custom", 0, 0, 0, false };
+    bool hasCustom = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* value;
+        if ((value = optionValue(argv[i], "--enemies"))) { custom.enemies = atoi(value); hasCustom = true; }
+        else if ((value = optionValue(argv[i], "--walls"))) { custom.walls = atoi(value); hasCustom = true; }
+        else if ((value = optionValue(argv[i], "--troops"))) { custom.troops = atoi(value); hasCustom = true; }
+        else if ((value = optionValue(argv[i], "--layout"))) { custom.walledIn = strcmp(value, "walled") == 0; hasCustom = true; }
+        else if ((value = optionValue(argv[i], "--ticks"))) options.ticks = atoi(value);
+        else if ((value = optionValue(argv[i], "--rounds"))) options.rounds = atoi(value);
+        else if ((value = optionValue(argv[i], "--threads"))) options.threads = atoi(value);
+        else if ((value = optionValue(argv[i], "--map")) && MapSize::parse(value, options.map)) continue;
+        else if ((value = optionValue(argv[i], "--waves")) && loadSpawnTable(value, options.waves)) continue;
+        else {
+            fprintf(stderr, "usage: %s [--enemies=N] [--walls=M] [--troops=K] [--layout=open|walled]"
+                            " [--ticks=T] [--rounds=R] [--threads=W] [--map=WxH]"
+                            " [--waves=classic|siege|<file>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    vector<Scenario> scenarios;
+    if (hasCustom) {
+        scenarios.push_back(custom);
+    } else {
+        scenarios = {
+            { "empty", 0, 0, 0, false },
+            { "open-small", 20, 20, 10, false },
+            { "open-large", 1000, 100, 500, false },
+            { "walled-small", 20, 60, 10, true },
+            { "walled-large", 1000, 200, 500, true },
+            { "walls-only", 0, 200, 0, false },
+        };
+    }
+
+    MapSize map = options.map.clamped();
+    printf("distance kernel: %s\n", distanceKernelName());
+    printf("map: %dx%d, %zu spawn table rows\n", map.width, map.height, options.waves.size());
+    printHeader();
+    for (const auto& scenario : scenarios) {
+        printRow(scenario, run(scenario, options));
+    }
+    return 0;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file VillageHostBench.cpp
+ * @brief Throughput and tick latency of many villages in one process
+ *
+ * Runs N independent villages on a VillageHost and reports aggregate
+ * village-ticks per second, per-tick latency percentiles over all
+ * villages, how late cadenced ticks started, and how many ticks ran on a
+ * worker that stole the village.
+ *
+ *   village_host [--villages=N] [--threads=W] [--ticks=T] [--seconds=S]
+ *                [--tick-ms=A[-B]] [--pin] [--scale] [--check]
+ *                [--map=WxH] [--waves=classic|siege|<file>]
+ *
+ * --tick-ms gives every village a cadence; with a range, the villages'
+ * cadences are spread evenly over it. Without it villages tick back to
+ * back. --scale repeats the run with 1, 2, 4, ... up to W threads.
+ * --check steps every village alone afterwards and compares digests.
+ */
+
+#include "VillageHost.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+struct Options {
+    int villages = 64;
+    int threads = 0;
+    uint64_t ticks = 1000;
+    double seconds = 0;
+    int tickMsLow = 0;
+    int tickMsHigh = 0;
+    bool pin = false;
+    bool scale = false;
+    bool check = false;
+    MapSize map;
+    SpawnTable waves = classicSpawnTable();
+};
+
+VillageConfig villageConfig(const Options& options, int i) {
+    VillageConfig config;
+    config.seed = static_cast<uint64_t>(i) + 1;
+    config.size = options.map;
+    config.waves = options.waves;
+    int span = options.tickMsHigh - options.tickMsLow;
+    int ms = options.tickMsLow + (options.villages > 1 ? span * i / (options.villages - 1) : 0);
+    config.tickMicros = static_cast<uint32_t>(ms) * 1000;
+    return config;
+}
+
+void fillHost(VillageHost& host, const Options& options) {
+    for (int i = 0; i < options.villages; ++i) host.addVillage(villageConfig(options, i));
+}
+
+void printHeader() {
+    printf("%7s %6s %9s %15s %7s %9s %9s %9s %9s %9s %8s\n", "threads", "pinned", "seconds", "village-ticks/s",
+           "speedup", "tick p50", "tick p99", "tick max", "lag avg", "lag max", "steals");
+}
+
+void printRow(const HostReport& report, double baseline) {
+    const VillageStats& all = report.all;
+    double lagAvgUs = all.ticks ? static_cast<double>(all.lagNs) / all.ticks / 1e3 : 0;
+    printf("%7d %6d %9.3f %15.0f %6.2fx %7.1fus %7.1fus %7.1fus %7.1fus %7.1fus %8" PRIu64 "\n",
+           report.threads, report.pinned, report.seconds, report.villageTicksPerSecond,
+           baseline > 0 ? report.villageTicksPerSecond / baseline : 1.0,
+           all.percentileNs(0.50) / 1e3, all.percentileNs(0.99) / 1e3, all.maxTickNs / 1e3,
+           lagAvgUs, all.maxLagNs / 1e3, report.steals);
+}
+
+// Steps every village alone to the tick it reached on the host and compares digests
+int mismatches(const VillageHost& host, const Options& options) {
+    int bad = 0;
+    for (int i = 0; i < options.villages; ++i) {
+        VillageConfig config = villageConfig(options, i);
+        World alone(config.seed, 1, config.size, config.waves);
+        const World& hosted = host.getWorld(static_cast<size_t>(i));
+        alone.step(static_cast<int>(hosted.getTick()));
+        if (alone.getTick() != hosted.getTick() || alone.digest() != hosted.digest()) ++bad;
+    }
+    return bad;
+}
+
+// Returns the value of "--name=value", or nullptr if arg is a different option
+const char* optionValue(const char* arg, const char* name) {
+    size_t length = strlen(name);
+    if (strncmp(arg, name, length) != 0 || arg[length] != '=') return nullptr;
+    return arg + length + 1;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    bool usage = false;
+    bool ticksGiven = false;
+    for (int i = 1; i < argc; ++i) {
+        const char* value;
+        if ((value = optionValue(argv[i], "--villages"))) options.villages = atoi(value);
+        else if ((value = optionValue(argv[i], "--threads"))) options.threads = atoi(value);
+        else if ((value = optionValue(argv[i], "--ticks"))) { options.ticks = strtoull(value, nullptr, 10); ticksGiven = true; }
+        else if ((value = optionValue(argv[i], "--seconds"))) options.seconds = atof(value);
+        else if ((value = optionValue(argv[i], "--tick-ms"))) {
+            int low = 0, high = 0;
+            int fields = sscanf(value, "%d-%d", &low, &high);
+            options.tickMsLow = low;
+            options.tickMsHigh = fields == 2 ? high : low;
+            usage = fields < 1 || low < 0 || options.tickMsHigh < low;
+        }
+        else if (strcmp(argv[i], "--pin") == 0) options.pin = true;
+        else if (strcmp(argv[i], "--scale") == 0) options.scale = true;
+        else if (strcmp(argv[i], "--check") == 0) options.check = true;
+        else if ((value = optionValue(argv[i], "--map")) && MapSize::parse(value, options.map)) continue;
+        else if ((value = optionValue(argv[i], "--waves")) && loadSpawnTable(value, options.waves)) continue;
+        else usage = true;
+    }
+    // A time limit alone runs until the time is up
+    if (options.seconds > 0 && !ticksGiven) options.ticks = 0;
+    if (usage || options.villages < 1 || (options.ticks == 0 && options.seconds <= 0)) {
+        fprintf(stderr, "usage: %s [--villages=N] [--threads=W] [--ticks=T] [--seconds=S] [--tick-ms=A[-B]]"
+                        " [--pin] [--scale] [--check] [--map=WxH] [--waves=classic|siege|<file>]\n", argv[0]);
+        return 2;
+    }
+
+    int maxThreads = options.threads > 0 ? options.threads
+                                         : static_cast<int>(max(1u, thread::hardware_concurrency()));
+    vector<int> threadCounts;
+    if (options.scale) {
+        for (int t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    }
+    threadCounts.push_back(maxThreads);
+
+    MapSize map = options.map.clamped();
+    printf("villages: %d on %dx%d maps, %zu spawn table rows, ", options.villages, map.width, map.height,
+           options.waves.size());
+    if (options.tickMsHigh > 0) printf("ticks every %d-%d ms", options.tickMsLow, options.tickMsHigh);
+    else printf("ticks back to back");
+    if (options.ticks > 0) printf(", %" PRIu64 " ticks each", options.ticks);
+    if (options.seconds > 0) printf(", %.1f s limit", options.seconds);
+    printf("; %u hardware threads\n", thread::hardware_concurrency());
+    printHeader();
+
+    double baseline = 0;
+    int status = 0;
+    for (int threads : threadCounts) {
+        HostOptions hostOptions;
+        hostOptions.threads = threads;
+        hostOptions.pinThreads = options.pin;
+        VillageHost host(hostOptions);
+        fillHost(host, options);
+
+        HostReport report = host.run(options.ticks, options.seconds);
+        if (baseline == 0) baseline = report.villageTicksPerSecond;
+        printRow(report, baseline);
+
+        if (options.check) {
+            int bad = mismatches(host, options);
+            if (bad > 0) {
+                fprintf(stderr, "%d villages differ from stepping them alone\n", bad);
+                status = 1;
+            }
+        }
+    }
+    if (options.check && status == 0) printf("every village matches stepping it alone\n");
+    return status;
+}
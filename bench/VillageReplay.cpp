@@ -0,0 +1,122 @@
+/**
+ * @file VillageReplay.cpp
+ * @brief Headless, full-speed replay of a recorded game session
+ *
+ * Re-runs the seed, spawn table and command stream saved by the game with
+ * VILLAGE_RECORD=<file>: each command is applied after the same number of
+ * ticks as in the session, with no rendering and no waiting between
+ * ticks. Reports ticks per second and the final state, and exits with
+ * status 1 if the end state differs from the recorded one.
+ *
+ *   village_replay <recording> [--rounds=R] [--threads=W]
+ */
+
+#include "World.h"
+#include "Recording.h"
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+namespace {
+
+// Runs the recording once; returns the world in its end state, or nullptr
+// (with the reason in error) if the game ended before the recording did
+unique_ptr<World> replay(const Recording& recording, int threads, string& error) {
+    unique_ptr<World> world(new World(recording.getSeed(), threads, recording.getSize(), recording.getWaves()));
+    for (const auto& entry : recording.getCommands()) {
+        uint64_t pending = entry.tick - world->getTick();
+        if (world->step(static_cast<int>(pending)) != static_cast<int>(pending)) {
+            error = "game over at tick " + to_string(world->getTick()) +
+                    ", before the command recorded at tick " + to_string(entry.tick);
+            return nullptr;
+        }
+        world->handleCommand(entry.command);
+    }
+    uint64_t pending = recording.getEndTick() - world->getTick();
+    world->step(static_cast<int>(pending));
+    return world;
+}
+
+void printState(const World& world) {
+    const Board& board = world.getBoard();
+    const Resources& resources = board.getPlayer().getResources();
+    const UnitStore& units = board.getUnits();
+    printf("final tick:       %" PRIu64 "%s\n", world.getTick(), world.isGameOver() ? " (game over)" : "");
+    printf("gold / elixir:    %d / %d\n", resources.gold, resources.elixir);
+    printf("town hall health: %d\n", board.getTownHall().getHealth());
+    printf("buildings:        %zu walls, %zu gold mines, %zu elixir collectors\n",
+           board.getWalls().size(), board.getGoldMines().size(), board.getElixirCollectors().size());
+    printf("units:            %zu enemies, %zu troops\n", units.enemyCount(), units.troopCount());
+    printf("digest:           %016" PRIx64 "\n", world.digest());
+}
+
+// Returns the value of "--name=value", or nullptr if arg is a different option
+const char* optionValue(const char* arg, const char* name) {
+    size_t length = strlen(name);
+    if (strncmp(arg, name, length) != 0 || arg[length] != '=') return nullptr;
+    return arg + length + 1;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = nullptr;
+    int rounds = 1;
+    int threads = 0;
+    bool usage = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* value;
+        if ((value = optionValue(argv[i], "--rounds"))) rounds = atoi(value);
+        else if ((value = optionValue(argv[i], "--threads"))) threads = atoi(value);
+        else if (argv[i][0] != '-' && !path) path = argv[i];
+        else usage = true;
+    }
+    if (usage || !path || rounds < 1) {
+        fprintf(stderr, "usage: %s <recording> [--rounds=R] [--threads=W]\n", argv[0]);
+        return 2;
+    }
+
+    Recording recording;
+    string error;
+    if (!recording.load(path, &error)) {
+        fprintf(stderr, "%s: %s\n", path, error.c_str());
+        return 2;
+    }
+    printf("recording:        seed %" PRIu64 ", %dx%d map, %zu wave rows, %zu commands, %" PRIu64 " ticks\n",
+           recording.getSeed(), recording.getSize().width, recording.getSize().height,
+           recording.getWaves().size(), recording.getCommands().size(), recording.getEndTick());
+
+    // Every round replays from scratch; the fastest one is reported
+    double bestSeconds = 0;
+    unique_ptr<World> world;
+    for (int round = 0; round < rounds; ++round) {
+        auto start = Clock::now();
+        world = replay(recording, threads, error);
+        double seconds = chrono::duration<double>(Clock::now() - start).count();
+        if (!world) {
+            fprintf(stderr, "replay diverged: %s\n", error.c_str());
+            return 1;
+        }
+        if (round == 0 || seconds < bestSeconds) bestSeconds = seconds;
+    }
+
+    printState(*world);
+    double ticksPerSecond = bestSeconds > 0 ? static_cast<double>(world->getTick()) / bestSeconds : 0;
+    printf("replay:           %.3f ms, %.0f ticks/s\n", bestSeconds * 1000.0, ticksPerSecond);
+
+    if (world->getTick() != recording.getEndTick() || world->digest() != recording.getEndDigest()) {
+        fprintf(stderr, "replay diverged: recorded end state is tick %" PRIu64 ", digest %016" PRIx64 "\n",
+                recording.getEndTick(), recording.getEndDigest());
+        return 1;
+    }
+    printf("end state matches the recording\n");
+    return 0;
+}
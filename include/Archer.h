@@ -1,27 +1,24 @@
 #ifndef VILLAGEGAME_ARCHER_H
 #define VILLAGEGAME_ARCHER_H
 
-#include "Troop.h"
+#include "Units.h"
 
 /**
- * Archer class - a ranged attack troop
+ * Archer - a ranged attack troop
  * Represented by bow emoji 🏹
+ *
+ * Archers hold their position while an enemy is within range but not
+ * adjacent, and shoot from there.
  */
-class Archer : public Troop {
-public:
-    /**
-     * Constructor for Archer
-     * @param x Initial x-coordinate
-     * @param y Initial y-coordinate
-     */
-    Archer(int x, int y);
-    
-    /**
-     * Attack an enemy if within range
-     * @param target The enemy to attack
-     * @return True if attack was successful, false otherwise
-     */
-    bool attack(std::shared_ptr<Enemy> target) override;
+template<>
+struct UnitType<UnitKind::ARCHER> {
+    static constexpr UnitStats stats = {
+        Glyph::BOW, 30, 15, 1, 4,
+        0, 30,  // 30 elixir
+        0,
+        "an Archer", "Archers",
+        FlowFieldMode::AVOID_WALLS  // Unused: troops follow the enemy field
+    };
 };
 
 #endif // VILLAGEGAME_ARCHER_H
@@ -1,27 +1,23 @@
 #ifndef VILLAGEGAME_BARBARIAN_H
 #define VILLAGEGAME_BARBARIAN_H
 
-#include "Troop.h"
+#include "Units.h"
 
 /**
- * Barbarian class - a melee attack troop
+ * Barbarian - a melee attack troop
  * Represented by barbarian emoji 🧔🏾‍♂️
+ *
+ * Barbarians can only attack adjacent enemies (range = 1).
  */
-class Barbarian : public Troop {
-public:
-    /**
-     * Constructor for Barbarian
-     * @param x Initial x-coordinate
-     * @param y Initial y-coordinate
-     */
-    Barbarian(int x, int y);
-    
-    /**
-     * Attack an enemy if adjacent
-     * @param target The enemy to attack
-     * @return True if attack was successful, false otherwise
-     */
-    bool attack(std::shared_ptr<Enemy> target) override;
+template<>
+struct UnitType<UnitKind::BARBARIAN> {
+    static constexpr UnitStats stats = {
+        Glyph::BARBARIAN, 60, 25, 1, 1,
+        25, 0,  // 25 gold
+        0,
+        "a Barbarian", "Barbarians",
+        FlowFieldMode::AVOID_WALLS  // Unused: troops follow the enemy field
+    };
 };
 
 #endif // VILLAGEGAME_BARBARIAN_H
@@ -2,57 +2,85 @@
 #define BOARD_H
 using namespace std;
 #include "Player.h"
-#include "TownHall.h"
-#include "Wall.h"
-#include "GoldMine.h"
-#include "ElixirCollector.h"
-#include "Enemy.h"
-#include "Troop.h"
-#include "Archer.h"
-#include "Barbarian.h"
+#include "BuildingStore.h"
+#include "Units.h"
+#include "EnemySystem.h"
+#include "TroopSystem.h"
+#include "ThreadPool.h"
+#include "OccupancyGrid.h"
+#include "FlowField.h"
+#include "SpatialHash.h"
+#include "Rng.h"
+#include "MapSize.h"
+#include "WaveScheduler.h"
 #include <vector>
 #include <string>
 #include <memory>
+#include <queue>
+#include <functional>
+
+/**
+ * @brief Completed tick at which a resource generator becomes full
+ */
+struct ResourceFullEvent {
+    uint64_t tick;
+    BuildingHandle generator;
+
+    bool operator>(const ResourceFullEvent& other) const { return tick > other.tick; }
+};
+
+struct ObservedDelta;
 
 class Board {
 private:
-    const int width = 147;
-    const int height = 33;
+    const int width;
+    const int height;
     const int margin = 30;
+    const size_t unitCapacity = 1024;  // Units per kind preallocated before the first tick
 
     Player player;
-    TownHall townhall;
-    vector<Wall> walls;
-    vector<GoldMine> goldMines;
-    vector<ElixirCollector> elixirCollectors;
-    vector<unique_ptr<Enemy>> enemies;
-    vector<unique_ptr<Troop>> troops;  // Collection of troops
-    vector<string> leftTexts;
-    int spawnCounter;
-    const int spawnRate;
+    BuildingStore buildings;     // Town Hall plus slot maps of walls, mines and collectors
+    OccupancyGrid occupancy;     // Building id per cell, kept in sync on place/destroy
+    uint32_t nextBuildingId = 1;
+    FlowField avoidWallsField;   // Town Hall distances with walls impassable (FlowFieldMode::AVOID_WALLS)
+    FlowField wallCostField;     // Town Hall distances with walls at extra cost (FlowFieldMode::WALL_COST)
+    bool fieldsBuilt = false;    // Fields are built on the first tick, so setup skips repairs
+    bool profilerTicks = true;   // update() closes a Profiler tick; the Profiler is process-wide
+    UnitStore units;                   // Enemies and troops, one archetype per kind
+    EnemyView enemyView;               // Enemy positions, index, health and distance field, gathered each tick for troops
+    Rng rng;                           // Seeded per-entity random streams
+    ThreadPool workers;                // Runs the decide phase of enemy and troop updates
+    vector<vector<BuildingHit>> buildingHits;  // Per-worker enemy damage
+    vector<Position> destroyedWalls;           // Scratch for flow field repairs
+    vector<int> troopTargets;                  // Enemy each troop attacks this tick, -1 for none
+    vector<TroopScratch> troopScratch;         // Per-worker nearest-enemy buffers for troops beyond the field
+    priority_queue<ResourceFullEvent, vector<ResourceFullEvent>, greater<ResourceFullEvent>>
+        fullEvents;                                // Pending "became full" icon changes, earliest first
+    WaveScheduler waves;                           // Spawn table, turned into one enemy batch per tick
     bool gameOver;
     
-    // Track enemy types for UI
-    int raiderCount;
-    int bombermanCount;
-    
-    // Track troop counts for UI
-    int archerCount = 0;
-    int barbarianCount = 0;
+    // Units of each kind ever spawned or trained, for the UI
+    int unitCounters[UNIT_KIND_COUNT] = {};
+
+    // Last player-facing message (training results etc.), shown by the front-end
+    string statusMessage;
 
-    void drawBuilding(const Building& building) const;
-    bool areBuildingsColliding(const Building& b1, const Building& b2) const;
+    void registerBuilding(BuildingHandle handle);
+    void onWallChanged(const Position& pos);
+    void settleFlowFields();
+    void scheduleFull(BuildingHandle generator);
+    const FlowField& fieldFor(UnitKind kind) const;
     bool isPositionOccupied(const Position& pos, const Building* ignore = nullptr) const;
-    bool CanBuild(const Building* building, const Building* ignore = nullptr) const;
-    void spawnEnemy();
+    bool isOnMap(const Position& pos) const;
+    bool isOnMap(const Building& building) const;
+    void spawnWaves();
     void updateEnemies();
     void updateTroops();  // New method to update troops
-    void renderTopBorder() const;
-    void renderBottomBorder() const;
-    void renderMiddle() const;
+    bool trainTroop(UnitKind kind);
 
 public:
-    Board();
+    explicit Board(uint64_t seed = Rng::DEFAULT_SEED, int threads = 0, MapSize size = MapSize(),
+                   SpawnTable spawnTable = classicSpawnTable());
     bool tryMovePlayer(char direction);
     bool placeWall();
     bool placeGoldMine();
@@ -62,20 +90,72 @@ public:
     void collectResources();
     void updateResources();
     void update();
-    void render();
+    bool CanBuild(const Building* building, const Building* ignore = nullptr) const;
+
+    // Read-only accessors used by front-ends (renderer, benchmarks)
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getMargin() const { return margin; }
+    MapSize getSize() const { return MapSize{width, height}; }
+    const Player& getPlayer() const { return player; }
+    const TownHall& getTownHall() const { return buildings.townhall; }
+    const SlotMap<Wall>& getWalls() const { return buildings.walls; }
+    const SlotMap<GoldMine>& getGoldMines() const { return buildings.goldMines; }
+    const SlotMap<ElixirCollector>& getElixirCollectors() const { return buildings.elixirCollectors; }
+    const BuildingStore& getBuildings() const { return buildings; }
+    const OccupancyGrid& getOccupancy() const { return occupancy; }
+    const UnitStore& getUnits() const { return units; }
+    int getUnitCounter(UnitKind kind) const { return unitCounters[static_cast<int>(kind)]; }
+    const string& getStatusMessage() const { return statusMessage; }
+    const SpawnTable& getSpawnTable() const { return waves.getTable(); }
+    bool isGameOver() const { return gameOver; }
+    uint64_t getSeed() const { return rng.getSeed(); }
+    uint64_t getTick() const { return rng.getTick(); }  // Completed updates
     
-    // Add a troop to the board
-    template<typename T>
-    bool addTroop(unique_ptr<T> troop) {
-        troops.push_back(std::move(troop));
-        // Increment appropriate counter based on troop type
-        if (dynamic_cast<Archer*>(troops.back().get())) {
-            archerCount++;
-        } else if (dynamic_cast<Barbarian*>(troops.back().get())) {
-            barbarianCount++;
-        }
-        return true;
-    }
+    // Add a unit of any kind to the board (spawns, training, scenarios)
+    void addUnit(UnitKind kind, int x, int y);
+
+    // Place a wall without cost or instance limit (scenarios); false if the cell is taken
+    bool addWall(int x, int y);
+
+    // Build the flow fields now rather than on the first tick (after scenario setup)
+    void buildFlowFields();
+
+    // Whether update() closes a Profiler tick; hosts running many boards at once turn it off
+    void setProfilerTicks(bool enabled) { profilerTicks = enabled; }
+
+    /**
+     * @brief Append the full board state to a snapshot buffer (see Snapshot.cpp)
+     *
+     * @param withFlowFields Include the flow field distances when they are built;
+     *        without them a loaded board rebuilds the fields on its first tick
+     */
+    void writeSnapshot(string& out, bool withFlowFields = true) const;
+
+    /**
+     * @brief Replace the state of a freshly constructed board with a snapshot
+     *
+     * @param data Snapshot bytes, as produced by writeSnapshot()
+     * @param size Number of bytes
+     * @return false if the data is truncated, does not fit this board, or holds
+     *         unknown icons, spawn table values past their enums, positions off the
+     *         map, or buildings that overlap, have no health in a game not yet lost,
+     *         or whose ids repeat or are not below the next building id
+     */
+    bool readSnapshot(const char* data, size_t size);
+
+    /**
+     * @brief Bring an observer's copy of a board up to date with a stream delta (see ObserverStream.cpp)
+     *
+     * Only the state observers draw is mirrored; the copy is never updated itself.
+     *
+     * @return false, leaving the board unchanged, if the delta holds unknown
+     *         icons or positions off the map
+     */
+    bool applyObservedDelta(const ObservedDelta& delta);
+
+    // Replace the player-facing message (observers mirroring another board)
+    void setStatusMessage(const string& message) { statusMessage = message; }
 };
 
 #endif
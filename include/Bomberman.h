@@ -1,43 +1,37 @@
 #ifndef BOMBERMAN_H
 #define BOMBERMAN_H
 
-#include "Enemy.h"
-#include <vector>
+#include "Units.h"
 
 /**
- * @brief Bomberman enemy class
+ * @brief Bomberman enemy
  * 
  * Bombermen prioritize destroying walls before attacking other buildings.
  * They are slower than Raiders but deal more damage.
+ * - Icon: "💣" (bomb)
+ * - Damage: 25 points per attack (higher than Raider)
+ * - Speed: 20 (slower than Raider)
  */
-class Bomberman : public Enemy {
-public:
-    /**
-     * @brief Constructor for Bomberman enemy
-     * 
-     * Creates a Bomberman with:
-     * - Icon: "💣" (bomb)
-     * - Damage: 25 points per attack (higher than Raider)
-     * - Speed: 20 (slower than Raider)
-     * 
-     * @param x Initial X-coordinate
-     * @param y Initial Y-coordinate
-     */
-    Bomberman(int x, int y);
-    
+template<>
+struct UnitType<UnitKind::BOMBERMAN> {
+    static constexpr UnitStats stats = {
+        Glyph::BOMB, 100, 25, 20, 1,
+        0, 0,  // Not trained
+        3,     // 30% random steps
+        "a Bomberman", "Bombermen",
+        FlowFieldMode::WALL_COST
+    };
+
     /**
-     * @brief Find target for Bomberman
+     * @brief Find target for a Bomberman
      * 
      * Bombermen prioritize walls over other buildings
      * 
-     * @param walls Vector of walls
-     * @param goldMines Vector of gold mines
-     * @param elixirCollectors Vector of elixir collectors
-     * @param townhall Town hall reference
-     * @return Pointer to the target building, or nullptr if no building is in range
+     * @param myPos Position of the Bomberman
+     * @param buildings Buildings to choose from
+     * @return Handle of the target building, or none if no building is in range
      */
-    Building* findTarget(vector<Wall>& walls, vector<GoldMine>& goldMines,
-                vector<ElixirCollector>& elixirCollectors, const TownHall& townhall) override;
+    static BuildingHandle findTarget(const Position& myPos, const BuildingStore& buildings);
 };
 
 #endif // BOMBERMAN_H
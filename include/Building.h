@@ -2,6 +2,8 @@
 #define BUILDING_H
 
 #include "Position.h"
+#include "Glyph.h"
+#include <cstdint>
 #include <string>
 using namespace std;
 class Building {
@@ -11,14 +13,15 @@ protected:
     int costGold, costElixir;
     int health;
     int maxInstances;
-    string icon;
+    Glyph icon;
     bool hasBorder;
+    uint32_t id;  // Assigned by the Board on placement, 0 = not placed
 public:
     Building(int x, int y, int sizeX, int sizeY, int costGold, int costElixir, 
-             int health, int maxInstances, const string& icon, bool hasBorder = true);
+             int health, int maxInstances, Glyph icon, bool hasBorder = true);
     
     const Position& getPosition() const;
-    const string& getIcon() const;
+    Glyph getIcon() const;
     int getCostGold() const;
     int getCostElixir() const;
     int getHealth() const;
@@ -26,8 +29,13 @@ public:
     int getSizeX() const;
     int getSizeY() const;
     bool Border() const;
+    Position closestPointTo(const Position& from) const;
+    uint32_t getId() const;
+    void setId(uint32_t newId);
     void setPosition(int x, int y);
     void takeDamage(int damage);
+    void setHealth(int newHealth) { health = newHealth; }
+    void setIcon(Glyph newIcon) { icon = newIcon; }
 };
 
 #endif
@@ -0,0 +1,87 @@
+#ifndef BUILDINGSTORE_H
+#define BUILDINGSTORE_H
+
+#include "SlotMap.h"
+#include "Distance.h"
+#include "OccupancyGrid.h"
+#include "TownHall.h"
+#include "Wall.h"
+#include "GoldMine.h"
+#include "ElixirCollector.h"
+#include <vector>
+
+/**
+ * @brief Safe reference to any building
+ *
+ * kind selects the container and slot the element in it. The Town Hall
+ * is not erasable and ignores slot. A default handle (kind NONE) refers
+ * to nothing; a handle to a removed building stops resolving.
+ */
+struct BuildingHandle {
+    BuildingKind kind = BuildingKind::NONE;
+    SlotHandle slot;
+
+    bool isNone() const { return kind == BuildingKind::NONE; }
+};
+
+/**
+ * @brief Every building of a board, in slot maps
+ *
+ * Buildings are addressed through BuildingHandles so references held by
+ * units survive other buildings being added or removed. Buildings whose
+ * health reaches zero through damage() are queued in destroyed; the
+ * board drains that list once per tick, so nothing is scanned when
+ * nothing died.
+ *
+ * Each slot map has a BoxArray of footprints in the same dense order for
+ * the batch distance kernels, so buildings are added and removed through
+ * the store rather than the maps directly.
+ */
+struct BuildingStore {
+    TownHall townhall;
+    SlotMap<Wall> walls;
+    SlotMap<GoldMine> goldMines;
+    SlotMap<ElixirCollector> elixirCollectors;
+    BoxArray wallBoxes;
+    BoxArray goldMineBoxes;
+    BoxArray elixirCollectorBoxes;
+    std::vector<BuildingHandle> destroyed;  // Dead list, in order of death
+
+    explicit BuildingStore(const TownHall& townhall);
+
+    /**
+     * @brief Store a building and its footprint
+     *
+     * @return Handle of the stored building
+     */
+    BuildingHandle add(const Wall& wall);
+    BuildingHandle add(const GoldMine& mine);
+    BuildingHandle add(const ElixirCollector& collector);
+
+    /**
+     * @brief Building a handle refers to, or nullptr if it is gone
+     */
+    Building* get(BuildingHandle handle);
+    const Building* get(BuildingHandle handle) const;
+
+    /**
+     * @brief Building covering an occupancy cell, or nullptr for an empty cell
+     */
+    const Building* get(const Occupant& cell) const { return get(BuildingHandle{cell.kind, cell.slot}); }
+
+    BuildingHandle townhallHandle() const { return BuildingHandle{BuildingKind::TOWNHALL, SlotHandle{}}; }
+
+    /**
+     * @brief Damage a building and queue it in destroyed when its health reaches zero
+     */
+    void damage(BuildingHandle handle, int amount);
+
+    /**
+     * @brief Remove a destroyed building (the Town Hall is never removed)
+     *
+     * @return false if the handle was stale or the Town Hall
+     */
+    bool remove(BuildingHandle handle);
+};
+
+#endif
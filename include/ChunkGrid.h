@@ -0,0 +1,168 @@
+#ifndef CHUNKGRID_H
+#define CHUNKGRID_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Side of a map chunk in cells (a power of two)
+ */
+constexpr int CHUNK_SHIFT = 5;
+constexpr int CHUNK_SIZE = 1 << CHUNK_SHIFT;
+constexpr int CHUNK_CELLS = CHUNK_SIZE * CHUNK_SIZE;
+
+/**
+ * @brief Cell grid stored as fixed-size chunks allocated on first write
+ *
+ * The map is split into CHUNK_SIZE x CHUNK_SIZE chunks. A chunk that was
+ * never written costs one null pointer and reads as the empty value, so
+ * memory follows the area that holds data rather than the map size.
+ * Cells of a chunk are row-major and contiguous.
+ *
+ * Coordinates must be inside the grid; callers check bounds.
+ */
+template<typename T>
+class ChunkGrid {
+private:
+    int width;
+    int height;
+    int chunksX;
+    int chunksY;
+    T empty;
+    std::vector<std::unique_ptr<T[]>> chunks;
+    size_t allocated = 0;
+
+    size_t chunkOf(int x, int y) const {
+        return static_cast<size_t>(y >> CHUNK_SHIFT) * chunksX + (x >> CHUNK_SHIFT);
+    }
+    static int offsetOf(int x, int y) {
+        return ((y & (CHUNK_SIZE - 1)) << CHUNK_SHIFT) | (x & (CHUNK_SIZE - 1));
+    }
+
+public:
+    ChunkGrid(int width, int height, const T& empty = T())
+        : width(width), height(height),
+          chunksX((width + CHUNK_SIZE - 1) / CHUNK_SIZE),
+          chunksY((height + CHUNK_SIZE - 1) / CHUNK_SIZE),
+          empty(empty),
+          chunks(static_cast<size_t>(chunksX) * chunksY) {}
+
+    /**
+     * @brief Value of a cell; cells of unallocated chunks read as empty
+     */
+    const T& at(int x, int y) const {
+        const T* chunk = chunks[chunkOf(x, y)].get();
+        return chunk ? chunk[offsetOf(x, y)] : empty;
+    }
+
+    /**
+     * @brief Writable cell, allocating its chunk (filled with empty) if needed
+     */
+    T& cell(int x, int y) {
+        std::unique_ptr<T[]>& chunk = chunks[chunkOf(x, y)];
+        if (!chunk) {
+            chunk.reset(new T[CHUNK_CELLS]);
+            for (int i = 0; i < CHUNK_CELLS; ++i) chunk[i] = empty;
+            ++allocated;
+        }
+        return chunk[offsetOf(x, y)];
+    }
+
+    /**
+     * @brief Writable cell; a chunk this call allocates is passed to init(left, top) first
+     *
+     * For grids whose cells do not all start out equal: init fills in the
+     * new chunk, whose top-left cell is (left, top), before it is used.
+     */
+    template<typename Init>
+    T& cell(int x, int y, Init init) {
+        std::unique_ptr<T[]>& chunk = chunks[chunkOf(x, y)];
+        if (!chunk) {
+            cell(x, y);
+            init((x >> CHUNK_SHIFT) << CHUNK_SHIFT, (y >> CHUNK_SHIFT) << CHUNK_SHIFT);
+        }
+        return chunk[offsetOf(x, y)];
+    }
+
+    /**
+     * @brief Release every chunk, so all cells read as empty again
+     */
+    void clear() {
+        for (auto& chunk : chunks) chunk.reset();
+        allocated = 0;
+    }
+
+    /**
+     * @brief Visit every cell of the allocated chunks as visit(x, y, value)
+     *
+     * Cells of unallocated chunks all hold the empty value and are skipped.
+     */
+    template<typename Visitor>
+    void forEachAllocated(Visitor visit) const {
+        for (int cy = 0; cy < chunksY; ++cy) {
+            for (int cx = 0; cx < chunksX; ++cx) {
+                const T* chunk = chunks[static_cast<size_t>(cy) * chunksX + cx].get();
+                if (!chunk) continue;
+                int x0 = cx << CHUNK_SHIFT, y0 = cy << CHUNK_SHIFT;
+                for (int y = y0; y < y0 + CHUNK_SIZE && y < height; ++y) {
+                    for (int x = x0; x < x0 + CHUNK_SIZE && x < width; ++x) {
+                        visit(x, y, chunk[offsetOf(x, y)]);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Visit the cells of a rectangle that lie in allocated chunks
+     *
+     * Same as forEachAllocated() restricted to the rectangle, which is
+     * clipped to the grid; only the chunks overlapping it are looked at.
+     *
+     * @param x0 Left column
+     * @param y0 Top row
+     * @param x1 Right column (inclusive)
+     * @param y1 Bottom row (inclusive)
+     */
+    template<typename Visitor>
+    void forEachAllocatedIn(int x0, int y0, int x1, int y1, Visitor visit) const {
+        x0 = x0 < 0 ? 0 : x0;
+        y0 = y0 < 0 ? 0 : y0;
+        x1 = x1 >= width ? width - 1 : x1;
+        y1 = y1 >= height ? height - 1 : y1;
+        if (x0 > x1 || y0 > y1) return;
+        for (int cy = y0 >> CHUNK_SHIFT; cy <= y1 >> CHUNK_SHIFT; ++cy) {
+            for (int cx = x0 >> CHUNK_SHIFT; cx <= x1 >> CHUNK_SHIFT; ++cx) {
+                const T* chunk = chunks[static_cast<size_t>(cy) * chunksX + cx].get();
+                if (!chunk) continue;
+                int top = cy << CHUNK_SHIFT, left = cx << CHUNK_SHIFT;
+                int yEnd = top + CHUNK_SIZE - 1 < y1 ? top + CHUNK_SIZE - 1 : y1;
+                int xEnd = left + CHUNK_SIZE - 1 < x1 ? left + CHUNK_SIZE - 1 : x1;
+                for (int y = top < y0 ? y0 : top; y <= yEnd; ++y) {
+                    for (int x = left < x0 ? x0 : left; x <= xEnd; ++x) {
+                        visit(x, y, chunk[offsetOf(x, y)]);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Check whether the chunk holding a cell has been allocated
+     */
+    bool hasChunk(int x, int y) const { return chunks[chunkOf(x, y)] != nullptr; }
+
+    /**
+     * @brief Check whether a chunk, numbered row by row, has been allocated
+     */
+    bool hasChunkAt(size_t index) const { return chunks[index] != nullptr; }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getChunksX() const { return chunksX; }
+    int getChunksY() const { return chunksY; }
+    size_t allocatedChunks() const { return allocated; }
+};
+
+#endif
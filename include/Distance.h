@@ -0,0 +1,77 @@
+#ifndef DISTANCE_H
+#define DISTANCE_H
+
+#include "Building.h"
+#include "Position.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Squared Euclidean distance between two cells
+ */
+inline int squaredDistance(const Position& a, const Position& b) {
+    int dx = a.x - b.x;
+    int dy = a.y - b.y;
+    return dx * dx + dy * dy;
+}
+
+/**
+ * @brief Squared Euclidean distance from a cell to the nearest cell of a box
+ *
+ * The box is inclusive on both ends; a cell inside it is at distance 0.
+ */
+inline int squaredDistanceToBox(int px, int py, int minX, int minY, int maxX, int maxY) {
+    int dx = px < minX ? minX - px : (px > maxX ? px - maxX : 0);
+    int dy = py < minY ? minY - py : (py > maxY ? py - maxY : 0);
+    return dx * dx + dy * dy;
+}
+
+/**
+ * @brief Building footprints stored as parallel coordinate arrays
+ *
+ * The structure-of-arrays layout lets the batch kernels load several
+ * boxes per instruction. Index i matches the owner's dense index i.
+ */
+struct BoxArray {
+    std::vector<int32_t> minX;
+    std::vector<int32_t> minY;
+    std::vector<int32_t> maxX;
+    std::vector<int32_t> maxY;
+
+    size_t size() const { return minX.size(); }
+
+    /**
+     * @brief Append the footprint of a building
+     */
+    void push(const Building& building);
+
+    /**
+     * @brief Move the last box into slot i and drop the last (mirrors SlotMap::erase)
+     */
+    void swapRemove(size_t i);
+};
+
+/**
+ * @brief Closest box to a cell within a squared radius
+ *
+ * Runs an AVX2 or SSE4.1 kernel when the CPU supports it (chosen once at
+ * run time) and a scalar loop otherwise; all three return the same
+ * result. Ties are broken by the lower index.
+ *
+ * @param boxes Footprints to search
+ * @param px Query column
+ * @param py Query row
+ * @param maxDistanceSquared Largest accepted squared distance (inclusive)
+ * @param distanceSquared If not null, receives the distance of the result
+ * @return Index of the closest box, or -1 if none is within range
+ */
+int nearestBoxWithin(const BoxArray& boxes, int px, int py, int maxDistanceSquared,
+                     int* distanceSquared = nullptr);
+
+/**
+ * @brief Name of the kernel nearestBoxWithin() dispatches to ("avx2", "sse4.1" or "scalar")
+ */
+const char* distanceKernelName();
+
+#endif
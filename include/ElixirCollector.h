@@ -7,8 +7,8 @@ class ElixirCollector : public ResourceGenerator {
 public:
     ElixirCollector(int x, int y);
     ElixirCollector& operator=(const ElixirCollector& other);
-    void update() override;
-    int collect() override;
+    void showFull() override;
+    void showEmpty() override;
 };
 
 #endif
@@ -0,0 +1,131 @@
+#ifndef ENEMYFIELD_H
+#define ENEMYFIELD_H
+
+#include "ChunkGrid.h"
+#include "OccupancyGrid.h"
+#include "Position.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Distance from every cell to the nearest enemy, around buildings
+ *
+ * Rebuilt once per tick by a breadth-first search seeded from every enemy
+ * at once, so each cell learns its distance to whichever enemy is closest
+ * in 4-way steps. Cells covered by a building cannot be entered: they get
+ * a distance (a troop standing on one can still step off it) but the
+ * search does not continue through them. Occupancy is read only for the
+ * cells the search reaches. Troops then step to a neighbour with a lower
+ * distance, an O(1) lookup however many enemies there are.
+ *
+ * The search stops as soon as every cell passed to build() as a reader
+ * has its distance: that is all nextStep() needs, and troops usually
+ * fight close to the enemies. It also stops after a budget of cells
+ * proportional to the number of readers, so readers walled off from every
+ * enemy or far from all of them cannot make it cover the map. Readers it
+ * did not reach (see reached()) take a straightStep() toward the nearest
+ * enemy instead. Only the cells reached are reset on the next build, so a
+ * tick costs the area searched, not the map. Cells are stored in
+ * ChunkGrid chunks allocated when the search or a reader first touches
+ * them, so memory follows the area around units rather than the map.
+ */
+class EnemyField {
+public:
+    static constexpr uint32_t UNREACHABLE = 0xFFFFFFFFu;
+
+    // Cells searched per reader before the search gives up, about the cost
+    // of one nearest-enemy query
+    static constexpr size_t SEARCH_CELLS_PER_READER = 64;
+    // Cells always allowed, so small maps are covered whole
+    static constexpr size_t MIN_SEARCH_CELLS = 1024;
+
+    /**
+     * @brief Create an empty field
+     *
+     * @param width Grid width
+     * @param height Grid height
+     * Both at most 65536. The play area must leave at least one cell to
+     * every grid edge.
+     *
+     * @param minX Leftmost playable column
+     * @param minY Topmost playable row
+     * @param maxX Rightmost playable column
+     * @param maxY Bottom playable row
+     */
+    EnemyField(int width, int height, int minX, int minY, int maxX, int maxY);
+
+    /**
+     * @brief Search from the enemies until every reader has a distance
+     *
+     * @param enemies Enemy positions; all are sources at distance 0
+     * @param readers Cells that will call nextStep() (the troops)
+     * @param grid Building occupancy, the obstacles
+     */
+    void build(const std::vector<Position>& enemies, const std::vector<Position>& readers,
+               const OccupancyGrid& grid);
+
+    /**
+     * @brief Check whether the last build gave a cell its distance
+     *
+     * nextStep() only routes from reached cells; the others use straightStep().
+     */
+    bool reached(const Position& pos) const;
+
+    /**
+     * @brief Steps from a cell to the nearest enemy
+     *
+     * @return Distance, or UNREACHABLE for cells walled off from every
+     *         enemy, outside the play area or not reached by the last build
+     */
+    uint32_t distanceAt(int x, int y) const;
+
+    /**
+     * @brief Best next cell from a position
+     *
+     * @param from Current position, one of the last build's readers
+     * @return Enterable neighbour with a lower distance (straight moves
+     *         tried up, down, left, right), or from itself if there is none
+     */
+    Position nextStep(const Position& from) const;
+
+    /**
+     * @brief One straight step toward a target, for readers the search did not reach
+     *
+     * @param from Current position
+     * @param target Position to move towards (the nearest enemy)
+     * @return Neighbour along the axis with the greater distance, or from
+     *         itself if a building covers it or it leaves the play area
+     */
+    Position straightStep(const Position& from, const Position& target) const;
+
+private:
+    // Set on the distance of a cell that a building covers
+    static constexpr uint32_t OBSTACLE = 0x80000000u;
+    // Distance of every cell outside the play area, never reached
+    static constexpr uint32_t OUTSIDE = UNREACHABLE - 2;
+    // Distance of a reader not reached yet
+    static constexpr uint32_t READER = UNREACHABLE - 1;
+
+    int width;
+    int height;
+    int minX, minY, maxX, maxY;
+    // A reached cell: its key for the search, its distance for the reset
+    struct Reached {
+        uint32_t key;
+        uint32_t* cell;
+    };
+
+    ChunkGrid<uint32_t> dist;            // UNREACHABLE except for OUTSIDE, readers and the cells in queue
+    std::vector<Reached> queue;          // Cells reached by the last build, in search order
+    std::vector<uint32_t*> readerCells;  // Cells marked as readers by the last build
+    const OccupancyGrid* obstacles = nullptr;  // Grid of the last build
+
+    bool inPlayArea(int x, int y) const { return x >= minX && x <= maxX && y >= minY && y <= maxY; }
+    // Cells in the queue are keyed as y << 16 | x, which sorts them row by row
+    static uint32_t pack(int x, int y) { return static_cast<uint32_t>(y) << 16 | static_cast<uint32_t>(x); }
+    static int unpackX(uint32_t key) { return static_cast<int>(key & 0xFFFF); }
+    static int unpackY(uint32_t key) { return static_cast<int>(key >> 16); }
+    uint32_t& touch(int x, int y);
+};
+
+#endif
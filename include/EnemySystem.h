@@ -0,0 +1,86 @@
+#ifndef ENEMYSYSTEM_H
+#define ENEMYSYSTEM_H
+
+#include "Units.h"
+#include "FlowField.h"
+#include "BuildingStore.h"
+#include "Rng.h"
+#include "ThreadPool.h"
+#include "Profiler.h"
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Damage an enemy queued against a building during the decide phase
+ */
+struct BuildingHit {
+    BuildingHandle building;
+    int damage;
+};
+
+/**
+ * @brief Updates every enemy of one archetype for a tick
+ * 
+ * For each enemy:
+ * 1. Continues attacking if already attacking a building
+ * 2. Otherwise, when its speed counter is due, attacks a building in range
+ *    (chosen by the kind's targeting rule)
+ * 3. Otherwise follows the flow field toward the Town Hall with randomized
+ *    variations in path
+ * 
+ * Runs in two phases. The decide phase spreads enemies over the thread
+ * pool; it only reads buildings and queues damage per worker. The apply
+ * phase then sums the queued damage into the buildings on the calling
+ * thread. Damage is a sum, so the outcome does not depend on the number
+ * of workers or the order their chunks ran in.
+ * Buildings destroyed by the damage are queued in buildings.destroyed.
+ *
+ * The archetype's kind picks, once per call, the update instantiated for
+ * that kind (UnitTypes.h): its stats are constants and its targeting
+ * rule is called directly, with no branching on kind per enemy.
+ * 
+ * @param enemies Raider or Bomberman archetype
+ * @param field Distance field toward the Town Hall matching the kind's wall handling
+ * @param rng Random streams of the current tick, one per enemy id
+ * @param buildings Buildings that can be attacked
+ * @param pool Workers for the decide phase
+ * @param hits Reused per-worker damage buffers
+ * @return true if town hall is destroyed (game over), false otherwise
+ */
+bool updateEnemyArchetype(UnitArchetype& enemies, const FlowField& field, const Rng& rng,
+                          BuildingStore& buildings, ThreadPool& pool, vector<vector<BuildingHit>>& hits);
+
+/**
+ * @brief Squared distance below which an enemy can attack a building
+ *
+ * Matches the former truncated Euclidean test dist < 2.
+ */
+constexpr int ATTACK_REACH_SQUARED = 4;
+
+/**
+ * @brief Replace a candidate target with a building of one kind that is strictly closer
+ *
+ * Searches the footprints of one slot map with the batch distance kernel.
+ * Calling it once per kind in priority order keeps the earlier kind on
+ * equal distances.
+ *
+ * @param pos Position of the attacker
+ * @param kind Kind of the buildings in boxes
+ * @param buildings Slot map the footprints mirror
+ * @param boxes Footprints of buildings, in dense order
+ * @param best Current candidate; replaced when a closer building is found
+ * @param bestDistSquared Squared distance of best (ATTACK_REACH_SQUARED when there is none)
+ */
+template<typename T>
+void closerTarget(const Position& pos, BuildingKind kind, const SlotMap<T>& buildings, const BoxArray& boxes,
+                  BuildingHandle& best, int& bestDistSquared) {
+    PROFILE_COUNT(Metric::DISTANCE_EVALS, boxes.size());
+    int dist;
+    int index = nearestBoxWithin(boxes, pos.x, pos.y, bestDistSquared - 1, &dist);
+    if (index < 0) return;
+    best = BuildingHandle{kind, buildings.handleAt(static_cast<size_t>(index))};
+    bestDistSquared = dist;
+}
+
+#endif
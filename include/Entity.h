@@ -2,16 +2,17 @@
 #define ENTITY_H
 using namespace std;
 #include "Position.h"
+#include "Glyph.h"
 #include <string>
 
 class Entity {
 protected:
     Position pos;
-    string icon;
+    Glyph icon;
 public:
-    Entity(int x, int y, const string& icon);
+    Entity(int x, int y, Glyph icon);
     const Position& getPosition() const;
-    const string& getIcon() const;
+    Glyph getIcon() const;
     void setPosition(int x, int y);
     void setPosition(const Position& newPos) { pos = newPos; }
 };
@@ -0,0 +1,221 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include "ChunkGrid.h"
+#include "OccupancyGrid.h"
+#include "Position.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// How a flow field treats the area around walls
+enum class FlowFieldMode {
+    AVOID_WALLS, // Cells next to a wall are impassable (Raiders)
+    WALL_COST    // Cells next to a wall are passable at a higher cost (Bombermen)
+};
+
+/**
+ * @brief Shared distance field toward a target building
+ *
+ * Holds the travel cost from cells of the play area to the target
+ * footprint using 8-way moves. Enemies step to the neighbour with the
+ * lowest distance, which is an O(1) lookup no matter how many enemies or
+ * walls there are.
+ *
+ * The field is searched outward from the target only as far as the
+ * enemies need: build() seeds the footprint, and settle() resumes the
+ * search until the cells it is given have their final distance. Since
+ * costs are small integers, the search is Dijkstra with a ring of buckets
+ * (Dial's algorithm) that is kept between calls. Cells are stored in
+ * ChunkGrid chunks that are allocated, and get their costs from the
+ * walls, when the search first enters them, so a large map costs the area
+ * within the farthest enemy's distance of the target rather than its size.
+ * When walls change the field is repaired locally instead of searched
+ * again.
+ *
+ * A wall blocks every cell within one step of it (the same area the old
+ * per-enemy wall collision scan blocked).
+ */
+class FlowField {
+public:
+    static constexpr uint32_t UNREACHABLE = 0xFFFFFFFFu;
+    static constexpr uint16_t BLOCKED = 0xFFFFu;
+
+    /**
+     * @brief Create an empty field
+     *
+     * @param width Grid width
+     * @param height Grid height
+     * Both at most 65536. The play area must leave at least one cell to
+     * every grid edge.
+     *
+     * @param minX Leftmost playable column
+     * @param minY Topmost playable row
+     * @param maxX Rightmost playable column
+     * @param maxY Bottom playable row
+     * @param mode Wall handling
+     * @param wallCost Cost of entering a cell next to a wall in WALL_COST mode
+     */
+    FlowField(int width, int height, int minX, int minY, int maxX, int maxY,
+              FlowFieldMode mode, uint16_t wallCost = 4);
+
+    /**
+     * @brief Start the field over from the target
+     *
+     * Releases every chunk and seeds the target footprint at distance 0;
+     * settle() searches from there.
+     *
+     * @param grid Occupancy grid used for wall positions; must outlive the field
+     * @param target Building whose footprint is the goal
+     */
+    void build(const OccupancyGrid& grid, const Building& target);
+
+    /**
+     * @brief Resume the search until the given cells can step along the field
+     *
+     * Afterwards each cell that can be entered has its final distance, and
+     * so does every neighbour closer to the target; for cells that cannot
+     * be entered, every neighbour has. nextStep() and distanceAt() then
+     * answer for those cells as a field searched over the whole map would.
+     * The search stops early once it has reached every cell it can.
+     *
+     * @param cells Positions that will step along the field (the enemies)
+     */
+    void settle(const std::vector<Position>& cells);
+
+    /**
+     * @brief Search state, for snapshots: every distance below it is final
+     */
+    uint32_t getSearchLevel() const { return level; }
+
+    /**
+     * @brief Distances of the allocated chunks, for snapshots
+     *
+     * @param chunkIds Receives the index of each allocated chunk, row by row
+     * @param distances Receives CHUNK_CELLS distances per chunk, in chunk cell order
+     */
+    void saveChunks(std::vector<uint32_t>& chunkIds, std::vector<uint32_t>& distances) const;
+
+    /**
+     * @brief Load chunks saved from a field with the same walls and target
+     *
+     * Cell costs and the goal are cheap to derive and are recomputed; the
+     * search resumes where the saved field left it.
+     *
+     * @param grid Occupancy grid used for wall positions; must outlive the field
+     * @param target Building whose footprint is the goal
+     * @param searchLevel getSearchLevel() of the saved field
+     * @param chunkIds Chunks from saveChunks()
+     * @param distances Distances from saveChunks()
+     * @return false if the chunks or distances cannot come from such a field
+     */
+    bool restore(const OccupancyGrid& grid, const Building& target, uint32_t searchLevel,
+                 const std::vector<uint32_t>& chunkIds, const std::vector<uint32_t>& distances);
+
+    /**
+     * @brief Repair the field after walls changed inside a rectangle
+     *
+     * Recomputes the cost of searched cells in the rectangle and propagates
+     * the difference: cells whose shortest path ran through a cell that got
+     * more expensive are invalidated and re-seeded from their neighbours,
+     * then a Dijkstra pass spreads any improvement up to the search level;
+     * what lies beyond it is left to settle(). Cells that are not affected
+     * are left untouched.
+     *
+     * @param grid Occupancy grid after the change
+     * @param x0 Left column of the changed area
+     * @param y0 Top row of the changed area
+     * @param x1 Right column of the changed area (inclusive)
+     * @param y1 Bottom row of the changed area (inclusive)
+     */
+    void repair(const OccupancyGrid& grid, int x0, int y0, int x1, int y1);
+
+    /**
+     * @brief Travel cost from a cell to the target
+     *
+     * Final for the cells settle() covered; elsewhere an upper bound.
+     *
+     * @return Distance, or UNREACHABLE for blocked, walled-off, off-map
+     *         or not yet searched cells
+     */
+    uint32_t distanceAt(int x, int y) const;
+
+    /**
+     * @brief Check whether a cell can be entered
+     */
+    bool isPassable(int x, int y) const;
+
+    /**
+     * @brief Best next cell from a position
+     *
+     * @param from Current position, covered by the last settle()
+     * @return Neighbour with the lowest distance, or from itself if no
+     *         neighbour is closer to the target
+     */
+    Position nextStep(const Position& from) const;
+
+    /**
+     * @brief Chunks the search has entered
+     */
+    size_t allocatedChunks() const { return cells.allocatedChunks(); }
+
+private:
+    struct Cell {
+        uint32_t dist;
+        uint16_t cost;   // Cost of entering the cell, BLOCKED if impassable
+        uint8_t goal;
+        uint8_t flags;   // QUEUED, INVALID
+    };
+    static constexpr uint8_t QUEUED = 1;   // Waiting in the bucket of its distance
+    static constexpr uint8_t INVALID = 2;  // Repair scratch; clear between repairs
+
+    using HeapEntry = std::pair<uint32_t, uint32_t>;  // (distance, cell key)
+
+    int width;
+    int height;
+    int minX, minY, maxX, maxY;
+    FlowFieldMode mode;
+    uint16_t wallCost;
+    uint32_t maxCost;                     // Largest cost of a passable cell
+    ChunkGrid<Cell> cells;                // Unsearched chunks read as unreachable and blocked
+    const OccupancyGrid* walls = nullptr; // Grid of the last build, read when a chunk is allocated
+    uint32_t level = 0;                   // Next distance to expand; distances below it are final
+    size_t pending = 0;                   // QUEUED cells
+    // Dial's ring: bucket d % size holds the cells waiting at distance d,
+    // all within maxCost of level. Kept between settle() calls.
+    std::vector<std::vector<uint32_t>> buckets;
+    // Work lists reused by every repair, so wall changes do not allocate
+    std::vector<uint32_t> raisedScratch;
+    std::vector<uint32_t> loweredScratch;
+    std::vector<uint32_t> invalidatedScratch;
+    std::vector<HeapEntry> frontierScratch;
+
+    bool inPlayArea(int x, int y) const { return x >= minX && x <= maxX && y >= minY && y <= maxY; }
+    // Cells in work lists are keyed as y << 16 | x
+    static uint32_t pack(int x, int y) { return static_cast<uint32_t>(y) << 16 | static_cast<uint32_t>(x); }
+    static int unpackX(uint32_t key) { return static_cast<int>(key & 0xFFFF); }
+    static int unpackY(uint32_t key) { return static_cast<int>(key >> 16); }
+    uint16_t cellCost(const OccupancyGrid& grid, int x, int y) const;
+    Cell& touch(int x, int y);
+    void costChunk(int left, int top);
+    void reset(const OccupancyGrid& grid, uint32_t searchLevel);
+    void settleCell(int x, int y);
+    void expandLevel();
+    void lower(Cell& cell, uint32_t key, uint32_t d);
+    void dequeue(Cell& cell);
+    void relaxNeighbours(int x, int y, Cell& cell, uint32_t d);
+    void propagate();
+
+    // Calls visit(x, y) for every cell of the target footprint in the play area
+    template<typename Visitor>
+    void forEachGoalCell(const Building& target, Visitor visit) const {
+        const Position& pos = target.getPosition();
+        for (int y = pos.y; y < pos.y + target.getSizeY(); ++y) {
+            for (int x = pos.x; x < pos.x + target.getSizeX(); ++x) {
+                if (inPlayArea(x, y)) visit(x, y);
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include "Glyph.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Double-buffered terminal cell grid with differential output
+ *
+ * A frame is composed into the back buffer with put()/putText(), then
+ * present() compares it with the front buffer (what the terminal shows)
+ * and emits only the changed cells, with cursor moves coalesced, in a
+ * single write() to stdout (or another descriptor). The buffers are then swapped.
+ *
+ * Cells hold GlyphTable ids, so they compare as integers and their bytes
+ * and widths are table lookups. A wide
+ * glyph (emoji) occupies its cell plus a continuation cell to its right;
+ * overwriting either half blanks the other so the terminal never shows a
+ * torn glyph. Coordinates are 1-based like ANSI cursor positions.
+ */
+class FrameBuffer {
+private:
+    struct Cell {
+        uint16_t glyph;  // Glyph id, CONTINUATION for the right half of a wide glyph
+        uint8_t width;   // Display columns of the glyph (1 or 2), 0 for a continuation
+        bool operator==(const Cell& other) const { return glyph == other.glyph && width == other.width; }
+        bool operator!=(const Cell& other) const { return !(*this == other); }
+    };
+
+    static constexpr uint16_t CONTINUATION = 0xFFFF;
+    static constexpr uint16_t UNKNOWN = 0xFFFE;  // Front buffer content after invalidate()
+
+    int columns;
+    int rows;
+    std::vector<Cell> front;
+    std::vector<Cell> back;
+    std::string output;       // Reused escape-sequence buffer
+    size_t lastFrameBytes;
+    bool fullRedraw;
+    int outputFd;
+
+    void setCell(int x, int y, Cell cell);
+    void moveCursor(int x, int y);
+
+public:
+    /**
+     * @brief Create a buffer of the given size, blank and pending a full redraw
+     */
+    FrameBuffer(int columns, int rows);
+
+    /**
+     * @brief Reset the back buffer to spaces before composing a frame
+     */
+    void clear();
+
+    /**
+     * @brief Place one glyph at a cell; wide glyphs also cover the next cell
+     *
+     * Glyphs that do not fit inside the buffer whole are skipped.
+     */
+    void put(int x, int y, Glyph glyph);
+
+    /**
+     * @brief Place a run of ASCII text starting at a cell, clipped to the buffer
+     */
+    void putText(int x, int y, const std::string& text);
+
+    /**
+     * @brief Emit the difference with the previous frame and swap buffers
+     *
+     * Nothing is written when the frame did not change.
+     *
+     * @param cursorX Column to leave the cursor at afterwards
+     * @param cursorY Row to leave the cursor at afterwards
+     */
+    void present(int cursorX, int cursorY);
+
+    /**
+     * @brief Forget what the terminal shows; the next present() redraws everything
+     */
+    void invalidate();
+
+    /**
+     * @brief Choose where present() writes; -1 composes frames without writing
+     */
+    void setOutputFd(int fd) { outputFd = fd; }
+
+    /**
+     * @brief Bytes written by the last present()
+     */
+    size_t getLastFrameBytes() const { return lastFrameBytes; }
+
+    /**
+     * @brief Escape sequences produced by the last present()
+     */
+    const std::string& getLastFrame() const { return output; }
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef GLYPH_H
+#define GLYPH_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Interned glyph id: an index into the GlyphTable
+ *
+ * Ids below ASCII_GLYPHS are printable ASCII (id = c - ' ', so blank is
+ * 0). The named values are the glyphs the game draws; front-ends may
+ * intern more at run time.
+ */
+enum class Glyph : uint16_t {
+    PLAYER = '~' - ' ' + 1,  // 👷
+    TOWNHALL,        // 🏰
+    WALL,            // 🧱
+    ROCK,            // 🪨 empty gold mine
+    COIN,            // 🪙 full gold mine
+    WATER_DROP,      // 💧 new elixir collector
+    TEST_TUBE,       // 🧪 full elixir collector
+    DOUBLE_BANG,     // ‼️ collected elixir collector
+    SWORD,           // 🗡️ raider
+    BOMB,            // 💣 bomberman
+    BOW,             // 🏹 archer
+    BARBARIAN        // 🧔🏾‍♂️ barbarian
+};
+
+constexpr uint16_t ASCII_GLYPHS = static_cast<uint16_t>(Glyph::PLAYER);
+
+/**
+ * @brief Process-wide registry of glyph bytes and display widths
+ *
+ * Each glyph's UTF-8 bytes and terminal width are computed once, so
+ * drawing is a table lookup. The simulation only stores ids; intern() is
+ * for front-ends and is not thread-safe.
+ */
+class GlyphTable {
+public:
+    /**
+     * @brief Id of a UTF-8 glyph, registering it on first use
+     */
+    static Glyph intern(const std::string& utf8);
+
+    /**
+     * @brief Id of a printable ASCII character (anything else maps to blank)
+     */
+    static Glyph ascii(char c) {
+        return static_cast<Glyph>(c >= ' ' && c <= '~' ? c - ' ' : 0);
+    }
+
+    /**
+     * @brief Check whether an id is in the table (ASCII, named or interned)
+     *
+     * Ids read from files or the network are checked with this before use.
+     */
+    static bool isKnown(Glyph glyph);
+
+    /**
+     * @brief UTF-8 bytes of a glyph; ids not in the table read as blank
+     */
+    static const std::string& bytes(Glyph glyph);
+
+    /**
+     * @brief Terminal columns a glyph occupies (1 or 2); 1 for ids not in the table
+     */
+    static int width(Glyph glyph);
+
+    /**
+     * @brief Number of terminal columns a UTF-8 glyph occupies
+     *
+     * Handles emoji (2 columns), variation selectors, skin tone modifiers
+     * and zero-width-joiner sequences (0 columns).
+     */
+    static int displayWidth(const std::string& utf8);
+};
+
+#endif
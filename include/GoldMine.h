@@ -7,8 +7,8 @@ class GoldMine : public ResourceGenerator {
 public:
     GoldMine(int x, int y);
     GoldMine& operator=(const GoldMine& other);
-    void update() override;
-    int collect() override;
+    void showFull() override;
+    void showEmpty() override;
 };
 
 #endif
@@ -2,14 +2,39 @@
 #define INPUTMANAGER_H
 
 #include <termios.h>
+#include <string>
+#include <vector>
 
+/**
+ * @brief Non-blocking keyboard reader for the terminal front-end
+ *
+ * Puts the terminal in non-canonical mode without echo. readCommands()
+ * drains everything waiting on stdin in one go and decodes it into
+ * command characters: arrow keys become U/D/L/R and letters are upper
+ * cased. An escape sequence cut off at the end of a read is completed by
+ * the next one.
+ */
 class InputManager {
 private:
     termios originalTerminalSettings;
+    std::string pending;  // Start of an escape sequence split across reads
+
 public:
     InputManager();
     ~InputManager();
-    char getInput() const;
+
+    /**
+     * @brief Descriptor to poll for input
+     */
+    int fd() const;
+
+    /**
+     * @brief Read all available input and append the decoded commands
+     *
+     * @param commands Receives one character per command, in typing order
+     * @return false once stdin is closed
+     */
+    bool readCommands(std::vector<char>& commands);
 };
 
 #endif
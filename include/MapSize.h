@@ -0,0 +1,34 @@
+#ifndef MAPSIZE_H
+#define MAPSIZE_H
+
+#include <string>
+
+/**
+ * @brief Dimensions of a board in cells, including the left margin and the border
+ *
+ * The play area spans columns margin + 1 .. width - 2 and rows 1 .. height - 2.
+ */
+struct MapSize {
+    static constexpr int DEFAULT_WIDTH = 147;
+    static constexpr int DEFAULT_HEIGHT = 33;
+    static constexpr int MIN_WIDTH = 64;
+    static constexpr int MIN_HEIGHT = 16;
+    static constexpr int MAX_SIDE = 4096;
+
+    int width = DEFAULT_WIDTH;
+    int height = DEFAULT_HEIGHT;
+
+    /**
+     * @brief The same size limited to MIN_WIDTH/MIN_HEIGHT .. MAX_SIDE
+     */
+    MapSize clamped() const;
+
+    /**
+     * @brief Parse "<width>x<height>", e.g. "2048x1024"
+     *
+     * @return false if text is not of that form
+     */
+    static bool parse(const std::string& text, MapSize& size);
+};
+
+#endif
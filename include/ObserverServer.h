@@ -0,0 +1,94 @@
+#ifndef OBSERVERSERVER_H
+#define OBSERVERSERVER_H
+
+#include "ObserverStream.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Counters of an ObserverServer since it started listening
+ */
+struct ObserverStats {
+    uint64_t keyframes = 0;  // Keyframes encoded
+    uint64_t deltas = 0;     // Deltas encoded
+    uint64_t bytes = 0;      // Bytes written to all observers
+    uint64_t skipped = 0;    // Messages dropped for observers that fell behind
+};
+
+/**
+ * @brief Publishes a board to observers on a Unix domain socket
+ *
+ * Observers connect to the socket and receive the observer stream (see
+ * ObserverStream.h): a keyframe, then a delta after every publish().
+ * Each message is encoded once and written to every observer with one
+ * gather write straight from the encoder's buffers.
+ *
+ * Sockets are non-blocking and the simulation never waits for an
+ * observer. When a write is cut short, the rest of that message is kept
+ * and sent first on the next publish. An observer that still has not
+ * taken it by then has fallen behind: the messages it misses are dropped
+ * and it is skipped ahead to the next keyframe. Keyframes are only
+ * encoded when an observer needs one, at most every KEYFRAME_INTERVAL
+ * publishes, and nothing is encoded while nobody is listening.
+ */
+class ObserverServer {
+private:
+    struct Client {
+        int fd;
+        bool needsKeyframe;   // Missed a message; deltas are dropped until the next keyframe
+        std::string pending;  // Unsent end of the last message
+        size_t pendingOffset;
+    };
+
+    int listenFd = -1;
+    std::string path;
+    std::vector<Client> clients;
+    ObserverEncoder encoder;
+    uint64_t publishesSinceKeyframe = UINT64_MAX;
+    ObserverStats stats;
+
+    bool flush(Client& client);
+    void send(Client& client, const std::vector<iovec>& message, size_t bytes);
+    void dropClosed();
+
+public:
+    // Minimum publishes between two keyframes, however many observers ask for one
+    static constexpr uint64_t KEYFRAME_INTERVAL = 10;
+
+    ObserverServer() = default;
+    ~ObserverServer();
+
+    ObserverServer(const ObserverServer&) = delete;
+    ObserverServer& operator=(const ObserverServer&) = delete;
+
+    /**
+     * @brief Start listening on a socket path
+     *
+     * A stale socket file left at the path is replaced.
+     *
+     * @param error If not null, receives the reason listening failed
+     * @return false if the socket could not be created or bound
+     */
+    bool listen(const std::string& socketPath, std::string* error = nullptr);
+
+    /**
+     * @brief Descriptor to poll for new observers, -1 when not listening
+     */
+    int fd() const { return listenFd; }
+
+    /**
+     * @brief Accept every observer waiting to connect
+     */
+    void acceptClients();
+
+    /**
+     * @brief Send the board's changes since the last publish to every observer
+     */
+    void publish(const Board& board);
+
+    size_t clientCount() const { return clients.size(); }
+    const ObserverStats& getStats() const { return stats; }
+};
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef OBSERVERSTREAM_H
+#define OBSERVERSTREAM_H
+
+#include "Board.h"
+#include <cstdint>
+#include <string>
+#include <sys/uio.h>
+#include <vector>
+
+/**
+ * @brief Observer stream wire format
+ *
+ * A stream is a sequence of messages, each a StreamHeader followed by
+ * `bytes` of payload (a multiple of 8). All integers are little-endian.
+ *
+ *   KEYFRAME  uint32_t statusBytes, uint32_t padding, status text padded
+ *             to 8 bytes, then a board snapshot without flow fields
+ *             (see Snapshot.cpp)
+ *   DELTA     DeltaHeader, then per unit kind UnitPlace moved[],
+ *             UnitPlace spawned[], uint32_t died[], then BuildingState
+ *             changed[], added[], removed[], then the status text if it
+ *             changed, zero-padded to 8 bytes
+ *
+ * A delta holds everything that changed since the previous message, so an
+ * observer applies each one to the state it built from the last keyframe.
+ */
+constexpr uint16_t OBSERVER_STREAM_VERSION = 1;
+
+enum class StreamMessage : uint16_t {
+    KEYFRAME = 1,
+    DELTA = 2
+};
+
+struct StreamHeader {
+    uint16_t version;
+    uint16_t type;    // StreamMessage
+    uint32_t bytes;   // Payload bytes after this header
+    uint64_t tick;    // Completed ticks of the state the message describes
+};
+
+struct DeltaHeader {
+    int32_t playerX, playerY;
+    int32_t gold, elixir;
+    int32_t townhallHealth;
+    int32_t unitCounters[UNIT_KIND_COUNT];  // The board's spawned/trained counters shown by the UI
+    uint32_t moved[UNIT_KIND_COUNT];
+    uint32_t spawned[UNIT_KIND_COUNT];
+    uint32_t died[UNIT_KIND_COUNT];
+    uint32_t buildingsChanged, buildingsAdded, buildingsRemoved;
+    uint32_t statusBytes;   // Length of the new status text
+    uint8_t gameOver;
+    uint8_t statusChanged;  // Status text follows the arrays
+    uint8_t padding[2];
+};
+
+// A unit's id and cell; coordinates fit 16 bits up to MapSize::MAX_SIDE
+struct UnitPlace {
+    uint32_t id;
+    uint16_t x, y;
+};
+
+// A building's id, kind and the fields observers draw
+struct BuildingState {
+    uint32_t id;
+    uint8_t kind;     // BuildingKind
+    uint8_t padding;
+    uint16_t icon;    // Glyph
+    int32_t health;
+    uint16_t x, y;    // Only meaningful in added[]
+};
+
+/**
+ * @brief Delta message split into its sections, as an observer applies it
+ */
+struct ObservedDelta {
+    uint64_t tick = 0;
+    DeltaHeader header{};
+    std::vector<UnitPlace> moved[UNIT_KIND_COUNT];
+    std::vector<UnitPlace> spawned[UNIT_KIND_COUNT];
+    std::vector<uint32_t> died[UNIT_KIND_COUNT];
+    std::vector<BuildingState> changed, added, removed;
+    std::string status;
+};
+
+/**
+ * @brief Split a DELTA payload into its sections
+ *
+ * @return false if the payload is truncated or inconsistent
+ */
+bool decodeDelta(uint64_t tick, const char* payload, size_t bytes, ObservedDelta& delta);
+
+/**
+ * @brief Split a KEYFRAME payload into its status text and snapshot bytes
+ *
+ * @return false if the payload is truncated
+ */
+bool decodeKeyframe(const char* payload, size_t bytes, std::string& status, const char*& snapshot,
+                    size_t& snapshotBytes);
+
+/**
+ * @brief Encodes a board into keyframes and per-tick deltas
+ *
+ * The encoder remembers the state it last encoded (the baseline) and diffs
+ * the board against it. Units of an archetype are kept in increasing id
+ * order (ids are handed out in spawn order and removal preserves order),
+ * so each archetype is diffed in one merge pass. Buildings are diffed
+ * through an id-indexed table. Every section is a reused buffer, and a
+ * message goes out as an iovec list over them, so encoding a tick does not
+ * allocate once the buffers have grown to the peak size.
+ */
+class ObserverEncoder {
+private:
+    struct BuildingBaseline {
+        uint8_t kind = 0;  // BuildingKind, NONE if no such building
+        uint16_t icon = 0;
+        int32_t health = 0;
+        uint32_t seen = 0; // Last diff pass that found the building
+    };
+
+    // Baseline
+    std::vector<uint32_t> ids[UNIT_KIND_COUNT];
+    std::vector<Position> positions[UNIT_KIND_COUNT];
+    std::vector<BuildingBaseline> buildingById;
+    std::vector<uint32_t> buildingIds;      // Ids present in the baseline
+    std::vector<uint32_t> nextBuildingIds;  // Scratch for the next baseline's ids
+    std::string status;
+    uint32_t pass = 0;
+
+    // Outgoing message
+    StreamHeader header{};
+    DeltaHeader delta{};
+    std::vector<UnitPlace> moved[UNIT_KIND_COUNT];
+    std::vector<UnitPlace> spawned[UNIT_KIND_COUNT];
+    std::vector<uint32_t> died[UNIT_KIND_COUNT];
+    std::vector<BuildingState> changed, added, removed;
+    std::string keyframe;
+    std::vector<iovec> iov;
+    size_t messageBytes = 0;
+
+    void diffUnits(const UnitStore& units, bool record);
+    template<typename T>
+    void diffBuildings(const SlotMap<T>& buildings, BuildingKind kind, bool record);
+    void finishBuildings(bool record);
+    void diff(const Board& board, bool record);
+    void addSection(const void* data, size_t bytes);
+
+public:
+    /**
+     * @brief Encode the whole board and make it the baseline
+     *
+     * @return The message as buffers to write in order; valid until the next encode
+     */
+    const std::vector<iovec>& encodeKeyframe(const Board& board);
+
+    /**
+     * @brief Encode what changed since the baseline and make the board the new baseline
+     */
+    const std::vector<iovec>& encodeDelta(const Board& board);
+
+    /**
+     * @brief Total bytes of the last encoded message
+     */
+    size_t getMessageBytes() const { return messageBytes; }
+};
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef OCCUPANCYGRID_H
+#define OCCUPANCYGRID_H
+
+#include "Building.h"
+#include "ChunkGrid.h"
+#include "SlotMap.h"
+#include <cstdint>
+#include <vector>
+
+// Kind of building covering a cell
+enum class BuildingKind : uint8_t {
+    NONE,
+    TOWNHALL,
+    WALL,
+    GOLD_MINE,
+    ELIXIR_COLLECTOR
+};
+
+/**
+ * @brief Contents of one grid cell
+ *
+ * id is the Building id (0 when the cell is empty). kind and slot locate
+ * the building in its BuildingStore (the Town Hall has no slot).
+ */
+struct Occupant {
+    uint32_t id;
+    BuildingKind kind;
+    SlotHandle slot;
+};
+
+/**
+ * @brief Cell-indexed map of building footprints
+ *
+ * Stores the id of the building covering each cell so that point queries
+ * are O(1) and rectangle queries are O(area), independent of how many
+ * buildings exist. Kept in sync incrementally by the Board whenever a
+ * building is placed or destroyed. Cells outside the grid read as empty.
+ *
+ * Cells are stored in chunks allocated when the first building touches
+ * them, so a large map with a small village costs little memory.
+ */
+class OccupancyGrid {
+private:
+    int width;
+    int height;
+    ChunkGrid<Occupant> cells;
+
+    bool inBounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+
+public:
+    OccupancyGrid(int width, int height);
+
+    /**
+     * @brief Mark the footprint of a building as occupied
+     *
+     * @param building Building to stamp (uses its id, position and size)
+     * @param kind Kind recorded for each covered cell
+     * @param slot Slot of the building in its store, recorded with the kind
+     */
+    void place(const Building& building, BuildingKind kind, SlotHandle slot = SlotHandle());
+
+    /**
+     * @brief Clear the footprint of a building
+     *
+     * Only cells still owned by the building's id are cleared.
+     *
+     * @param building Building being removed
+     */
+    void remove(const Building& building);
+
+    /**
+     * @brief Get the occupant of a cell
+     *
+     * @return Occupant, or an empty occupant for cells off the grid
+     */
+    Occupant at(int x, int y) const;
+
+    /**
+     * @brief Check whether a cell holds a building of the given kind
+     */
+    bool hasKind(int x, int y, BuildingKind kind) const { return at(x, y).kind == kind; }
+
+    /**
+     * @brief Check whether a rectangle is free of buildings
+     *
+     * @param x Left column
+     * @param y Top row
+     * @param sizeX Width in cells
+     * @param sizeY Height in cells
+     * @param ignoreId Building id treated as empty (0 to ignore nothing)
+     * @return true if no cell in the rectangle belongs to another building
+     */
+    bool isAreaFree(int x, int y, int sizeX, int sizeY, uint32_t ignoreId = 0) const;
+
+    /**
+     * @brief Visit every cell covered by a building as visit(x, y, occupant)
+     *
+     * Only allocated chunks are scanned, so the cost follows the built-up
+     * area rather than the map size.
+     */
+    template<typename Visitor>
+    void forEachOccupied(Visitor visit) const {
+        cells.forEachAllocated([&](int x, int y, const Occupant& cell) {
+            if (cell.id != 0) visit(x, y, cell);
+        });
+    }
+
+    /**
+     * @brief Visit every covered cell of a rectangle as visit(x, y, occupant)
+     *
+     * Only the allocated chunks overlapping the rectangle are scanned, so
+     * the cost follows the rectangle, not the map.
+     *
+     * @param x0 Left column
+     * @param y0 Top row
+     * @param x1 Right column (inclusive)
+     * @param y1 Bottom row (inclusive)
+     */
+    template<typename Visitor>
+    void forEachOccupiedIn(int x0, int y0, int x1, int y1, Visitor visit) const {
+        cells.forEachAllocatedIn(x0, y0, x1, y1, [&](int x, int y, const Occupant& cell) {
+            if (cell.id != 0) visit(x, y, cell);
+        });
+    }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    size_t allocatedChunks() const { return cells.allocatedChunks(); }
+};
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Set to 0 (cmake -DVILLAGE_PROFILING=OFF) to compile every probe out
+#ifndef VILLAGE_PROFILING
+#define VILLAGE_PROFILING 1
+#endif
+
+// Everything the profiler measures; *_NS metrics are wall-clock nanoseconds
+enum class Metric : uint8_t {
+    TICK_NS,
+    SPAWN_NS,
+    ENEMIES_NS,
+    TROOPS_NS,
+    RESOURCES_NS,
+    FIND_TARGET_CALLS,   // Enemy target searches
+    DISTANCE_EVALS,      // Building footprints tested by target searches
+    BUILDINGS_ERASED,    // Destroyed buildings removed from the board
+    POOL_GROWTHS,        // Unit pools that ran out of preallocated room
+    UNITS_SPAWNED        // Enemies inserted by the wave scheduler
+};
+
+constexpr int METRIC_COUNT = 10;
+
+/**
+ * @brief Metric values of one thread
+ *
+ * Only the owning thread writes, with plain relaxed load/store pairs, so
+ * a probe never takes a lock or a locked instruction. The profiler sums
+ * every live thread's values when a tick ends.
+ */
+struct ThreadMetrics {
+    std::atomic<uint64_t> values[METRIC_COUNT];
+
+    ThreadMetrics();
+    ~ThreadMetrics();  // Folds the values into the profiler's retired totals
+};
+
+/**
+ * @brief Process-wide tick timers and counters
+ *
+ * Probes add to the calling thread's ThreadMetrics. endTick() turns the
+ * running totals into per-tick values and remembers the slowest tick, so
+ * a front-end can show where the time of the last (and the worst) tick
+ * went, and dump() writes a summary file.
+ */
+class Profiler {
+public:
+    static constexpr bool enabled() { return VILLAGE_PROFILING != 0; }
+
+    static void add(Metric metric, uint64_t amount) {
+        std::atomic<uint64_t>& value = local.values[static_cast<int>(metric)];
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Close the current tick: compute its values and track the slowest one
+     */
+    static void endTick();
+
+    /**
+     * @brief Value of a metric during the last completed tick
+     */
+    static uint64_t lastTick(Metric metric);
+
+    /**
+     * @brief Value of a metric during the tick with the highest TICK_NS
+     */
+    static uint64_t worstTick(Metric metric);
+
+    /**
+     * @brief Sum of a metric over every completed tick
+     */
+    static uint64_t total(Metric metric);
+
+    static uint64_t tickCount();
+    static const char* name(Metric metric);
+    static bool isTime(Metric metric) { return metric <= Metric::RESOURCES_NS; }
+
+    /**
+     * @brief Write totals, per-tick averages and the slowest tick to a file
+     *
+     * @return false if the file could not be written
+     */
+    static bool dump(const std::string& path);
+
+private:
+    static thread_local ThreadMetrics local;
+};
+
+/**
+ * @brief Adds the lifetime of the enclosing scope to a time metric
+ */
+class ScopedTimer {
+private:
+    Metric metric;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedTimer(Metric metric) : metric(metric), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        Profiler::add(metric, static_cast<uint64_t>(ns.count()));
+    }
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if VILLAGE_PROFILING
+#define PROFILE_SCOPE(metric) ScopedTimer PROFILE_CONCAT(profileScope, __LINE__)(metric)
+#define PROFILE_COUNT(metric, amount) Profiler::add(metric, amount)
+#define PROFILE_END_TICK() Profiler::endTick()
+#else
+#define PROFILE_SCOPE(metric) ((void)0)
+#define PROFILE_COUNT(metric, amount) ((void)0)
+#define PROFILE_END_TICK() ((void)0)
+#endif
+
+#endif
@@ -1,43 +1,37 @@
 #ifndef RAIDER_H
 #define RAIDER_H
 
-#include "Enemy.h"
-#include <vector>
+#include "Units.h"
 
 /**
- * @brief Raider enemy class
+ * @brief Raider enemy
  * 
  * Raiders attack any building except walls, prioritizing resource buildings and townhall.
  * They are faster than Bombermen but deal less damage.
+ * - Icon: "🗡️" (sword)
+ * - Damage: 15 points per attack
+ * - Speed: 12 (faster than Bomberman)
  */
-class Raider : public Enemy {
-public:
-    /**
-     * @brief Constructor for Raider enemy
-     * 
-     * Creates a Raider with:
-     * - Icon: "🗡️" (sword)
-     * - Damage: 15 points per attack
-     * - Speed: 12 (faster than Bomberman)
-     * 
-     * @param x Initial X-coordinate
-     * @param y Initial Y-coordinate
-     */
-    Raider(int x, int y);
-    
+template<>
+struct UnitType<UnitKind::RAIDER> {
+    static constexpr UnitStats stats = {
+        Glyph::SWORD, 100, 15, 12, 1,
+        0, 0,  // Not trained
+        2,     // 20% random steps
+        "a Raider", "Raiders",
+        FlowFieldMode::AVOID_WALLS
+    };
+
     /**
-     * @brief Find target for Raider
+     * @brief Find target for a Raider
      * 
      * Raiders attack any building except walls: prioritizing resource buildings and townhall
      * 
-     * @param walls Vector of walls (ignored by Raiders)
-     * @param goldMines Vector of gold mines (high priority)
-     * @param elixirCollectors Vector of elixir collectors (high priority)
-     * @param townhall Town hall reference (attacked if closest)
-     * @return Pointer to the closest building to attack, or nullptr if no building is in range
+     * @param myPos Position of the Raider
+     * @param buildings Buildings to choose from (walls are ignored)
+     * @return Handle of the closest building to attack, or none if no building is in range
      */
-    Building* findTarget(vector<Wall>& walls, vector<GoldMine>& goldMines,
-                vector<ElixirCollector>& elixirCollectors, const TownHall& townhall) override;
+    static BuildingHandle findTarget(const Position& myPos, const BuildingStore& buildings);
 };
 
 #endif // RAIDER_H
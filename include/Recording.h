@@ -0,0 +1,85 @@
+#ifndef RECORDING_H
+#define RECORDING_H
+
+#include "MapSize.h"
+#include "WaveScheduler.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One player command and when it was applied
+ */
+struct RecordedCommand {
+    uint64_t tick;   // World ticks completed when the command was applied
+    uint64_t ms;     // Wall-clock milliseconds since the session started
+    char command;    // World::handleCommand() letter
+};
+
+/**
+ * @brief Seed, map size, spawn table and command stream of a game session
+ *
+ * The simulation is deterministic given the seed, the map size, the spawn
+ * table and the tick each command was applied at, so a recording replays
+ * the session exactly;
+ * the millisecond stamps are kept for reference only. finish() stores
+ * the tick and World::digest() of the end state so a replay can check
+ * that it did not diverge.
+ *
+ * Saved as text, one line per command:
+ *   VILLREC 2
+ *   seed <seed>
+ *   map <width>x<height>      (optional, the default size if absent)
+ *   waves <rows>              (optional, the classic table if absent)
+ *   wave ...                  (rows lines, see formatWave())
+ *   <tick> <ms> <command>
+ *   end <tick> <digest in hex>
+ */
+class Recording {
+private:
+    uint64_t seed;
+    MapSize size;
+    SpawnTable waves;
+    std::vector<RecordedCommand> commands;
+    bool finished;
+    uint64_t endTick;
+    uint64_t endDigest;
+
+public:
+    explicit Recording(uint64_t seed = 0, MapSize size = MapSize(), SpawnTable waves = classicSpawnTable());
+
+    /**
+     * @brief Append a command applied after tick ticks
+     */
+    void add(uint64_t tick, uint64_t ms, char command);
+
+    /**
+     * @brief Record the end state of the session
+     */
+    void finish(uint64_t tick, uint64_t digest);
+
+    /**
+     * @brief Write the recording to a file
+     *
+     * @return false if the file could not be written
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Read a recording written by save()
+     *
+     * @param error If not null, receives the reason a load failed
+     * @return false if the file is missing, malformed or has no end state
+     */
+    bool load(const std::string& path, std::string* error = nullptr);
+
+    uint64_t getSeed() const { return seed; }
+    MapSize getSize() const { return size; }
+    const SpawnTable& getWaves() const { return waves; }
+    const std::vector<RecordedCommand>& getCommands() const { return commands; }
+    bool isFinished() const { return finished; }
+    uint64_t getEndTick() const { return endTick; }
+    uint64_t getEndDigest() const { return endDigest; }
+};
+
+#endif
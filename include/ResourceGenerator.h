@@ -2,16 +2,54 @@
 #define RESOURCEGENERATOR_H
 using namespace std;
 #include "Building.h"
+#include <cstdint>
 
+/**
+ * @brief Building that fills up over time until the player collects it
+ *
+ * Nothing is stored per tick: the generator remembers the tick it started
+ * filling at and derives its amount from the current tick. The board
+ * schedules the tick it becomes full (fullTick()) and calls showFull()
+ * then, so idle generators cost nothing per tick. Ticks count completed
+ * board updates.
+ */
 class ResourceGenerator : public Building {
 protected:
-    int currentAmount;
+    uint64_t fillStart;   // Tick of the last collection (or placement)
     const int capacity;
 public:
+    static const int RATE = 5;  // Amount produced per tick
+
     ResourceGenerator(int x, int y, int sizeX, int sizeY, int costGold, int costElixir,
-                     int health, int maxInstances, const string& icon, int capacity);
-    virtual void update() = 0;
-    virtual int collect() = 0;
+                     int health, int maxInstances, Glyph icon, int capacity);
+
+    /**
+     * @brief Start filling from empty at a tick
+     */
+    void startFilling(uint64_t tick) { fillStart = tick; }
+    uint64_t getFillStart() const { return fillStart; }
+
+    /**
+     * @brief Amount stored once tick ticks have completed
+     */
+    int amountAt(uint64_t tick) const;
+
+    /**
+     * @brief First tick at which the generator is full
+     */
+    uint64_t fullTick() const { return fillStart + (capacity + RATE - 1) / RATE; }
+
+    /**
+     * @brief Takes the stored amount if the generator is full and starts refilling
+     *
+     * @param tick Current tick
+     * @return The amount collected if full, 0 otherwise
+     */
+    int collect(uint64_t tick);
+
+    // Icon changes when the generator fills up and when it is emptied
+    virtual void showFull() = 0;
+    virtual void showEmpty() = 0;
 };
 
 #endif
@@ -0,0 +1,82 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+/**
+ * @brief Independent random stream of one entity for one tick
+ *
+ * Draw i is a pure function of (seed, tick, entity, i): no state is
+ * shared between streams, so entities can be updated in any order or on
+ * any thread and still see exactly the same numbers.
+ */
+class RngStream {
+private:
+    uint64_t key;      // Hash of (seed, tick, entity)
+    uint64_t counter;  // Draw index
+
+public:
+    static uint64_t mix(uint64_t z) {
+        // SplitMix64 finalizer: a bijective avalanche of all 64 bits
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    explicit RngStream(uint64_t key) : key(key), counter(0) {}
+
+    /**
+     * @brief Next 64 random bits
+     */
+    uint64_t next() { return mix(key + 0x9E3779B97F4A7C15ull * ++counter); }
+
+    /**
+     * @brief Uniform integer in [lo, hi]
+     *
+     * Uses a multiply-shift on 32 random bits; the bias is below 2^-28
+     * for the small ranges the game draws from.
+     */
+    int uniform(int lo, int hi) {
+        uint64_t span = static_cast<uint64_t>(hi - lo) + 1;
+        return lo + static_cast<int>(((next() >> 32) * span) >> 32);
+    }
+};
+
+/**
+ * @brief World random number service
+ *
+ * Holds the world seed and the current tick and hands out one RngStream
+ * per entity. The stream key is (seed, tick, entity id), and draws are
+ * numbered within the stream, so a run is fully reproduced by its seed
+ * and command sequence.
+ *
+ * Unit ids start at 1; id 0 is reserved for the enemy spawner.
+ */
+class Rng {
+private:
+    uint64_t seed;
+    uint64_t tick;
+
+public:
+    static constexpr uint64_t DEFAULT_SEED = 0x5EEDu;
+    static constexpr uint32_t SPAWNER = 0;
+
+    explicit Rng(uint64_t seed = DEFAULT_SEED, uint64_t tick = 0) : seed(seed), tick(tick) {}
+
+    /**
+     * @brief Move on to the next tick's streams
+     */
+    void advance() { ++tick; }
+
+    /**
+     * @brief Stream of an entity for the current tick
+     */
+    RngStream stream(uint32_t entity) const {
+        return RngStream(RngStream::mix(RngStream::mix(seed ^ RngStream::mix(tick)) + entity));
+    }
+
+    uint64_t getSeed() const { return seed; }
+    uint64_t getTick() const { return tick; }
+};
+
+#endif
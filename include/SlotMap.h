@@ -0,0 +1,134 @@
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Generation-checked reference to an element of a SlotMap
+ *
+ * A default-constructed handle refers to nothing.
+ */
+struct SlotHandle {
+    static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+
+    uint32_t index = INVALID;   // Slot in the map's indirection table
+    uint32_t generation = 0;    // Must match the slot's generation to resolve
+
+    bool operator==(const SlotHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Dense storage with stable, generation-checked handles
+ *
+ * Values are kept contiguous for iteration. Each value owns a slot that
+ * maps a handle to the value's current position; erase() moves the last
+ * value into the hole (O(1), nothing else shifts) and bumps the slot's
+ * generation, so handles to erased values stop resolving instead of
+ * dangling. Freed slots are reused.
+ */
+template<typename T>
+class SlotMap {
+private:
+    struct Slot {
+        uint32_t dense;       // Index into values while occupied
+        uint32_t generation;
+    };
+
+    std::vector<T> values;
+    std::vector<uint32_t> owners;     // Slot of each value
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+
+public:
+    /**
+     * @brief Store a value
+     *
+     * @return Handle to the stored value
+     */
+    SlotHandle insert(const T& value) {
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(slots.size());
+            slots.push_back(Slot{0, 0});
+        }
+        slots[slot].dense = static_cast<uint32_t>(values.size());
+        values.push_back(value);
+        owners.push_back(slot);
+        return SlotHandle{slot, slots[slot].generation};
+    }
+
+    /**
+     * @brief Value a handle refers to, or nullptr if it was erased
+     */
+    T* get(SlotHandle handle) {
+        if (handle.index >= slots.size() || slots[handle.index].generation != handle.generation) return nullptr;
+        return &values[slots[handle.index].dense];
+    }
+
+    const T* get(SlotHandle handle) const {
+        return const_cast<SlotMap*>(this)->get(handle);
+    }
+
+    bool contains(SlotHandle handle) const { return get(handle) != nullptr; }
+
+    /**
+     * @brief Remove a value by moving the last value into its place
+     *
+     * @return false if the handle was already stale
+     */
+    bool erase(SlotHandle handle) {
+        if (!contains(handle)) return false;
+
+        uint32_t hole = slots[handle.index].dense;
+        uint32_t last = static_cast<uint32_t>(values.size() - 1);
+        if (hole != last) {
+            values[hole] = values[last];
+            owners[hole] = owners[last];
+            slots[owners[hole]].dense = hole;
+        }
+        values.pop_back();
+        owners.pop_back();
+
+        ++slots[handle.index].generation;
+        freeSlots.push_back(handle.index);
+        return true;
+    }
+
+    /**
+     * @brief Dense position of the value a handle refers to, or -1 if it was erased
+     */
+    long indexOf(SlotHandle handle) const {
+        if (!contains(handle)) return -1;
+        return static_cast<long>(slots[handle.index].dense);
+    }
+
+    /**
+     * @brief Handle of the value at a dense position
+     */
+    SlotHandle handleAt(size_t i) const {
+        uint32_t slot = owners[i];
+        return SlotHandle{slot, slots[slot].generation};
+    }
+
+    size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+
+    T& operator[](size_t i) { return values[i]; }
+    const T& operator[](size_t i) const { return values[i]; }
+    T& back() { return values.back(); }
+
+    typename std::vector<T>::iterator begin() { return values.begin(); }
+    typename std::vector<T>::iterator end() { return values.end(); }
+    typename std::vector<T>::const_iterator begin() const { return values.begin(); }
+    typename std::vector<T>::const_iterator end() const { return values.end(); }
+};
+
+#endif
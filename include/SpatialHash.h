@@ -0,0 +1,184 @@
+#ifndef SPATIALHASH_H
+#define SPATIALHASH_H
+
+#include "Position.h"
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bucketed index of points for radius and nearest-neighbour queries
+ *
+ * The map is divided into square buckets of bucketSize cells. rebuild()
+ * groups the points by bucket and only touches the buckets that hold a
+ * point, so its cost follows the number of points rather than the map
+ * area (no per-point allocation either). Queries only visit the buckets
+ * that can contain an answer. Distances are Manhattan, matching troop
+ * attack ranges.
+ *
+ * Each point is identified by its index in the array passed to rebuild().
+ */
+class SpatialHash {
+private:
+    int bucketSize;
+    int bucketsX;
+    int bucketsY;
+    std::vector<int> bucketBegin;     // Offset of each bucket's points in entries
+    std::vector<int> bucketCount;     // Points per bucket, zero for buckets not in used
+    std::vector<int> used;            // Buckets holding points
+    std::vector<int> entries;         // Point indices grouped by bucket
+    std::vector<Position> points;     // Copy of the indexed positions
+    std::vector<int> pointBucket;     // Scratch bucket of each point used by rebuild()
+
+    int bucketOf(int coord, int count) const;
+
+    template<typename Visitor>
+    void forEachInBucket(int b, Visitor visit) const {
+        for (int e = bucketBegin[b], end = e + bucketCount[b]; e < end; ++e) visit(entries[e]);
+    }
+
+public:
+    /**
+     * @brief Create an index covering a width x height map
+     *
+     * @param width Map width in cells
+     * @param height Map height in cells
+     * @param bucketSize Side of a bucket in cells
+     */
+    SpatialHash(int width, int height, int bucketSize = 4);
+
+    /**
+     * @brief Replace the indexed points
+     *
+     * @param positions Positions to index; point i is positions[i]
+     */
+    void rebuild(const std::vector<Position>& positions);
+
+    /**
+     * @brief Visit every point within a Manhattan radius
+     *
+     * @param center Query position
+     * @param radius Maximum Manhattan distance (inclusive)
+     * @param visit Called as visit(index, distance)
+     */
+    template<typename Visitor>
+    void forEachWithin(const Position& center, int radius, Visitor visit) const {
+        int bx0 = bucketOf(center.x - radius, bucketsX);
+        int bx1 = bucketOf(center.x + radius, bucketsX);
+        int by0 = bucketOf(center.y - radius, bucketsY);
+        int by1 = bucketOf(center.y + radius, bucketsY);
+
+        for (int by = by0; by <= by1; ++by) {
+            for (int bx = bx0; bx <= bx1; ++bx) {
+                forEachInBucket(by * bucketsX + bx, [&](int i) {
+                    int d = std::abs(points[i].x - center.x) + std::abs(points[i].y - center.y);
+                    if (d <= radius) visit(i, d);
+                });
+            }
+        }
+    }
+
+    /**
+     * @brief Find the closest accepted point within a Manhattan radius
+     *
+     * Ties are broken by the lower index so results are deterministic.
+     *
+     * @param center Query position
+     * @param radius Maximum Manhattan distance (inclusive)
+     * @param accept Predicate on the point index; rejected points are skipped
+     * @return Index of the closest point, or -1 if none qualifies
+     */
+    template<typename Predicate>
+    int nearestWithin(const Position& center, int radius, Predicate accept) const {
+        int best = -1;
+        int bestDist = radius + 1;
+        forEachWithin(center, radius, [&](int i, int d) {
+            if ((d < bestDist || (d == bestDist && i < best)) && accept(i)) {
+                best = i;
+                bestDist = d;
+            }
+        });
+        return best;
+    }
+
+    /**
+     * @brief Find the k closest accepted points
+     *
+     * Searches rings of buckets outward from the query and stops as soon as
+     * no unvisited bucket can hold a closer point. When the rings have
+     * covered more buckets than there are points (sparse points on a large
+     * map) it scans the points directly instead; the result is the same.
+     *
+     * @param center Query position
+     * @param k Number of points wanted
+     * @param accept Predicate on the point index; rejected points are skipped
+     * @param out Receives (distance, index) pairs sorted by distance, then index
+     */
+    template<typename Predicate>
+    void kNearest(const Position& center, size_t k, Predicate accept,
+                  std::vector<std::pair<int, int>>& out) const;
+
+    /**
+     * @brief Find the k closest points
+     */
+    void kNearest(const Position& center, size_t k, std::vector<std::pair<int, int>>& out) const {
+        kNearest(center, k, [](int) { return true; }, out);
+    }
+
+    size_t size() const { return points.size(); }
+};
+
+template<typename Predicate>
+void SpatialHash::kNearest(const Position& center, size_t k, Predicate accept,
+                           std::vector<std::pair<int, int>>& out) const {
+    out.clear();
+    if (k == 0 || points.empty()) return;
+
+    // out stays sorted and holds at most k entries (k is small)
+    auto consider = [&](int i) {
+        int d = std::abs(points[i].x - center.x) + std::abs(points[i].y - center.y);
+        std::pair<int, int> candidate(d, i);
+        if (out.size() == k && !(candidate < out.back())) return;
+        if (!accept(i)) return;
+        if (out.size() == k) out.pop_back();
+        out.insert(std::upper_bound(out.begin(), out.end(), candidate), candidate);
+    };
+
+    int cbx = bucketOf(center.x, bucketsX);
+    int cby = bucketOf(center.y, bucketsY);
+    int maxRing = std::max(std::max(cbx, bucketsX - 1 - cbx), std::max(cby, bucketsY - 1 - cby));
+
+    size_t visited = 0;
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        if (visited > points.size()) {
+            out.clear();
+            for (size_t i = 0; i < points.size(); ++i) consider(static_cast<int>(i));
+            return;
+        }
+        for (int by = cby - ring; by <= cby + ring; ++by) {
+            if (by < 0 || by >= bucketsY) continue;
+            bool edgeRow = by == cby - ring || by == cby + ring;
+            int step = edgeRow ? 1 : 2 * ring;
+            for (int bx = cbx - ring; bx <= cbx + ring; bx += step) {
+                if (bx < 0 || bx >= bucketsX) continue;
+                forEachInBucket(by * bucketsX + bx, consider);
+                ++visited;
+            }
+        }
+
+        // Any point outside the searched square is at least one step past
+        // its nearest edge; stop once the k-th result is strictly closer so
+        // index tie-breaks stay exact
+        if (out.size() == k) {
+            int left = center.x - (cbx - ring) * bucketSize;
+            int right = (cbx + ring + 1) * bucketSize - 1 - center.x;
+            int top = center.y - (cby - ring) * bucketSize;
+            int bottom = (cby + ring + 1) * bucketSize - 1 - center.y;
+            int bound = std::min(std::min(left, right), std::min(top, bottom)) + 1;
+            if (out.back().first < bound) break;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef TERMINALRENDERER_H
+#define TERMINALRENDERER_H
+
+#include "Board.h"
+#include "FrameBuffer.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Draws a Board to the terminal
+ *
+ * Each frame is composed into a FrameBuffer and only the cells that
+ * changed since the previous frame are sent to the terminal. Part of the
+ * terminal front-end only; the simulation core never depends on it.
+ *
+ * The screen is a fixed-size viewport onto the map. It follows the
+ * player, stays inside the map, and shows the whole map when the map fits
+ * the screen. The left margin panel always covers the first screen
+ * columns. Buildings are drawn from the occupancy chunks under the
+ * viewport, so their cost follows the screen size, not the map. Units
+ * are not indexed between ticks; each is culled with one bounds check,
+ * so a frame also costs a comparison per unit.
+ */
+class TerminalRenderer {
+private:
+    FrameBuffer frame;
+    int columns;
+    int rows;
+    int viewX;     // Map cell shown at screen column 0 (off screen) and row 0
+    int viewY;
+    int playLeft;  // First screen column of the play area (the margin separator)
+    bool showProfile;
+    std::vector<std::string> leftTexts;  // Extra left margin lines, one per play-area row
+
+    void updateView(const Board& board);
+    bool inView(int x, int y, int sizeX, int sizeY) const;
+    void putMap(int x, int y, Glyph glyph);
+    void putMapText(int x, int y, const std::string& text);
+    void drawBuilding(const Building& building);
+    void renderBorder(const Board& board, int row);
+    void renderMiddle(const Board& board);
+    void fillProfilePanel();
+
+public:
+    /**
+     * @brief Create a renderer for a screen of the given size
+     *
+     * @param columns Screen width, margin panel included
+     * @param rows Screen height, borders included
+     */
+    TerminalRenderer(int columns, int rows);
+
+    /**
+     * @brief Render the entire game state, including the game over banner
+     *
+     * @param board Board to draw
+     */
+    void render(const Board& board);
+
+    /**
+     * @brief Force the next frame to redraw the whole screen
+     */
+    void invalidate() { frame.invalidate(); }
+
+    /**
+     * @brief Show or hide the profiler panel in the left margin
+     */
+    void toggleProfile() { showProfile = !showProfile; }
+
+    FrameBuffer& getFrameBuffer() { return frame; }
+    int getViewX() const { return viewX; }
+    int getViewY() const { return viewY; }
+};
+
+#endif
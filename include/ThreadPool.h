@@ -0,0 +1,85 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed set of worker threads for data-parallel loops
+ *
+ * parallelFor() splits an index range into chunks that the workers and
+ * the calling thread claim from a shared counter, and returns once every
+ * chunk is done. Each call gets a worker number in [0, size()) so callers
+ * can keep one output buffer per worker and merge them afterwards.
+ *
+ * Small loops run inline on the calling thread as worker 0, so a pool
+ * costs nothing when there is little work.
+ */
+class ThreadPool {
+private:
+    using Invoke = void (*)(void* body, size_t begin, size_t end, int worker);
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+
+    // Current job; written under the mutex before the generation bump
+    Invoke invoke;
+    void* body;
+    size_t count;
+    size_t grain;
+    std::atomic<size_t> next;
+    int busy;                // Workers that have not finished the current job
+    uint64_t generation;     // Bumped once per job
+    bool stopping;
+
+    void workerLoop(int worker);
+    void runChunks(int worker);
+    void run(size_t n, size_t chunk, Invoke fn, void* ctx);
+
+public:
+    /**
+     * @brief Start a pool
+     *
+     * @param workers Total number of workers including the calling thread;
+     *        0 uses the hardware concurrency
+     */
+    explicit ThreadPool(int workers = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Number of workers, including the calling thread
+     */
+    int size() const { return static_cast<int>(threads.size()) + 1; }
+
+    /**
+     * @brief Run fn(begin, end, worker) over [0, n) in chunks and wait
+     *
+     * @param n Number of items
+     * @param chunk Items per chunk; loops of at most one chunk run inline
+     * @param fn Called with a half-open item range and the worker number
+     */
+    template<typename Body>
+    void parallelFor(size_t n, size_t chunk, Body fn) {
+        if (n == 0) return;
+        if (threads.empty() || n <= chunk) {
+            fn(size_t(0), n, 0);
+            return;
+        }
+        run(n, std::max<size_t>(chunk, 1), [](void* ctx, size_t begin, size_t end, int worker) {
+            (*static_cast<Body*>(ctx))(begin, end, worker);
+        }, &fn);
+    }
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef TICKTIMER_H
+#define TICKTIMER_H
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Periodic simulation tick source for a poll() loop
+ *
+ * On Linux the period is kept by a timerfd: fd() becomes readable when
+ * ticks are due, so the loop sleeps in poll() between them. Elsewhere
+ * fd() is -1 and the loop polls with msUntilDue() as its timeout.
+ */
+class TickTimer {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    int timerFd;
+    Clock::duration period;
+    Clock::time_point nextTick;  // Used when there is no timerfd
+
+public:
+    /**
+     * @brief Start ticking every periodMs milliseconds
+     */
+    explicit TickTimer(int periodMs);
+    ~TickTimer();
+
+    TickTimer(const TickTimer&) = delete;
+    TickTimer& operator=(const TickTimer&) = delete;
+
+    /**
+     * @brief Descriptor to poll for POLLIN, or -1 without timerfd support
+     */
+    int fd() const { return timerFd; }
+
+    /**
+     * @brief Milliseconds until the next tick is due (0 if one is due now)
+     */
+    int msUntilDue() const;
+
+    /**
+     * @brief Number of ticks that came due since the last call
+     */
+    uint64_t takeDue();
+};
+
+#endif
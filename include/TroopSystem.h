@@ -0,0 +1,82 @@
+#ifndef TROOPSYSTEM_H
+#define TROOPSYSTEM_H
+
+#include "Units.h"
+#include "SpatialHash.h"
+#include "EnemyField.h"
+#include "OccupancyGrid.h"
+#include "ThreadPool.h"
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Per-worker buffers reused across ticks
+ */
+struct TroopScratch {
+    std::vector<std::pair<int, int>> nearest;
+};
+
+/**
+ * @brief Every enemy as the troops see it during a tick
+ *
+ * Enemies are numbered kind by kind in EnemyKinds order (UnitTypes.h),
+ * each in archetype order; the spatial hash uses the same point indices. Troop damage lands
+ * in health, a flat copy of the enemies' health, which is written back to
+ * the archetypes once after all troops have fought. The distance field is
+ * built once from the same positions, before any troop fights, and serves
+ * every troop kind.
+ */
+struct EnemyView {
+    SpatialHash index;
+    EnemyField field;
+    std::vector<Position> positions;
+    std::vector<int> health;
+    std::vector<Position> troopPositions;  // Readers of the field this tick
+
+    /**
+     * @param width Grid width
+     * @param height Grid height
+     * @param minX, minY, maxX, maxY Area troops and enemies move in
+     */
+    EnemyView(int width, int height, int minX, int minY, int maxX, int maxY)
+        : index(width, height), field(width, height, minX, minY, maxX, maxY) {}
+
+    /**
+     * @brief Copy the enemies' positions and health, rebuild the index and the field
+     *
+     * @param units Enemies to gather; the troops' positions bound the field's search
+     * @param grid Building occupancy, the obstacles of the field
+     */
+    void gather(const UnitStore& units, const OccupancyGrid& grid);
+
+    /**
+     * @brief Write the health back to the enemy archetypes
+     */
+    void scatter(UnitStore& units) const;
+};
+
+/**
+ * @brief Updates every troop of one archetype for a tick
+ *
+ * Each troop attacks the closest live enemy within range. If none is in
+ * range it takes one step down the enemy distance field, toward the
+ * nearest enemy around buildings. Troops the field's search did not reach
+ * (walled off, or beyond its budget) find the nearest enemy through the
+ * spatial index and step straight at it, never onto a building.
+ *
+ * The archetype's kind picks the update instantiated for that kind, so
+ * its range is a constant. Combat runs in two stages. Troops are decided in parallel against the
+ * enemy health at the start of the call, each recording the enemy it
+ * attacks (or -1) in targets. The damage is then summed into the flat
+ * enemy health on the calling thread, in troop order.
+ *
+ * @param troops Archer or Barbarian archetype
+ * @param enemies Enemy positions, index, health and distance field for this tick
+ * @param targets Reused buffer for the troops' target assignments
+ * @param pool Workers for the decide phase
+ * @param scratch Reused per-worker buffers
+ */
+void updateTroopArchetype(UnitArchetype& troops, EnemyView& enemies, std::vector<int>& targets, ThreadPool& pool,
+                          std::vector<TroopScratch>& scratch);
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef UNITTYPES_H
+#define UNITTYPES_H
+
+#include "Raider.h"
+#include "Bomberman.h"
+#include "Archer.h"
+#include "Barbarian.h"
+#include <type_traits>
+
+/**
+ * @brief Registry of unit kinds
+ *
+ * Adding a kind means a UnitKind value, a UnitType specialization in the
+ * kind's header, and an entry here: in UNIT_TYPES and in the enemy or
+ * troop list, which selects the system that updates it.
+ */
+
+template<UnitKind... Kinds>
+struct UnitKindList {
+    static constexpr int size = sizeof...(Kinds);
+
+    // Place of a kind in the list, or -1 if it is not listed
+    static constexpr int indexOf(UnitKind kind) {
+        const UnitKind kinds[] = { Kinds... };
+        for (int i = 0; i < size; ++i) {
+            if (kinds[i] == kind) return i;
+        }
+        return -1;
+    }
+};
+
+using EnemyKinds = UnitKindList<UnitKind::RAIDER, UnitKind::BOMBERMAN>;
+using TroopKinds = UnitKindList<UnitKind::ARCHER, UnitKind::BARBARIAN>;
+
+inline bool isEnemyKind(UnitKind kind) {
+    return EnemyKinds::indexOf(kind) >= 0;
+}
+
+/**
+ * @brief Stats of every kind, indexed by UnitKind
+ */
+constexpr UnitStats UNIT_TYPES[UNIT_KIND_COUNT] = {
+    UnitType<UnitKind::RAIDER>::stats,
+    UnitType<UnitKind::BOMBERMAN>::stats,
+    UnitType<UnitKind::ARCHER>::stats,
+    UnitType<UnitKind::BARBARIAN>::stats,
+};
+
+/**
+ * @brief Call visit(std::integral_constant<UnitKind, K>()) for each kind of a list, in order
+ *
+ * The visitor is instantiated once per kind, so code inside it can use
+ * UnitType<K> as compile-time constants.
+ */
+template<UnitKind... Kinds, typename Visitor>
+void forEachKind(UnitKindList<Kinds...>, Visitor&& visit) {
+    (visit(std::integral_constant<UnitKind, Kinds>()), ...);
+}
+
+#endif
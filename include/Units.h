@@ -0,0 +1,154 @@
+#ifndef UNITS_H
+#define UNITS_H
+
+#include "BuildingStore.h"
+#include "FlowField.h"
+#include "Position.h"
+#include "Glyph.h"
+#include <cstdint>
+#include <vector>
+
+// Kinds of mobile units; each kind is stored in its own archetype
+enum class UnitKind : uint8_t {
+    RAIDER,    // Enemy: attacks all buildings except walls
+    BOMBERMAN, // Enemy: specializes in destroying walls
+    ARCHER,    // Troop: ranged attacker
+    BARBARIAN  // Troop: melee attacker
+};
+
+constexpr int UNIT_KIND_COUNT = 4;
+
+/**
+ * @brief Constants shared by every unit of a kind
+ *
+ * Kept per kind rather than per unit, so units only carry the state that
+ * actually changes.
+ */
+struct UnitStats {
+    Glyph icon;
+    int health;           // Starting health
+    int damage;           // Damage per attack
+    int speed;            // Ticks between moves (lower is faster)
+    int range;            // Attack range (troops; enemies reach buildings within ATTACK_REACH_SQUARED)
+    int costGold;         // Training cost (troops)
+    int costElixir;
+    int deviationChance;  // Chance in 10 of a random step per move (enemies)
+    const char* label;    // Name with article, for status messages
+    const char* plural;   // Name of several, for the UI counters
+    FlowFieldMode fieldMode;  // Town Hall field the kind walks (enemies)
+};
+
+/**
+ * @brief Compile-time description of a unit kind
+ *
+ * Every kind specializes this in its own header with
+ * `static constexpr UnitStats stats`; enemy kinds also provide
+ * `static BuildingHandle findTarget(const Position&, const BuildingStore&)`.
+ * The systems are instantiated per kind over whole archetypes, so stats
+ * are constants and targeting is a direct call. UnitTypes.h lists the
+ * specializations.
+ */
+template<UnitKind K>
+struct UnitType;
+
+/**
+ * @brief Stats of a unit kind
+ */
+const UnitStats& unitStats(UnitKind kind);
+
+/**
+ * @brief Contiguous component storage for all units of one kind
+ *
+ * Component i of every array belongs to the same unit. Systems iterate
+ * over the arrays directly: no per-unit allocation, pointer chasing or
+ * virtual calls. The arrays double as the kind's pool: dead units are
+ * compacted away without releasing capacity, so once reserve() covers the
+ * peak population, spawning and dying never touch the heap.
+ */
+struct UnitArchetype {
+    UnitKind kind;
+    std::vector<uint32_t> id;           // Board-wide unit id, stable for the unit's lifetime
+    std::vector<Position> position;
+    std::vector<int> health;
+    std::vector<int> damage;
+    std::vector<int> speedCounter;      // Ticks since the last move
+    std::vector<BuildingHandle> target; // Building under attack, none while moving
+
+    explicit UnitArchetype(UnitKind kind);
+
+    size_t size() const { return id.size(); }
+    bool empty() const { return id.empty(); }
+    size_t capacity() const { return id.capacity(); }
+
+    /**
+     * @brief Preallocate room for n units
+     */
+    void reserve(size_t n);
+
+    /**
+     * @brief Append a unit with the kind's starting stats
+     */
+    void add(uint32_t unitId, const Position& pos);
+
+    /**
+     * @brief Append n units with the kind's starting stats in one operation
+     *
+     * Capacity is reserved once for the whole batch (at least doubling, so
+     * repeated batches stay amortized) and every component array is
+     * extended with a single range insert.
+     *
+     * @param firstId Id of the batch's first unit in spawn order
+     * @param order Place of each unit in spawn order; unit i gets firstId + order[i]
+     * @param positions Position of each unit
+     */
+    void addBatch(uint32_t firstId, const std::vector<uint32_t>& order, const std::vector<Position>& positions);
+
+    /**
+     * @brief Remove every unit with health <= 0 in one order-preserving pass
+     *
+     * @return Number of units removed
+     */
+    size_t removeDead();
+};
+
+/**
+ * @brief All unit archetypes plus the unit id counter
+ */
+class UnitStore {
+private:
+    std::vector<UnitArchetype> archetypes;  // Indexed by UnitKind
+    uint32_t nextId;
+
+public:
+    UnitStore();
+
+    /**
+     * @brief Create a unit of the given kind
+     *
+     * @return Id of the new unit
+     */
+    uint32_t spawn(UnitKind kind, const Position& pos);
+
+    /**
+     * @brief Claim n consecutive unit ids for a batch
+     *
+     * @return The first id
+     */
+    uint32_t takeIds(uint32_t n);
+
+    /**
+     * @brief Preallocate room for n units of every kind
+     */
+    void reserve(size_t n);
+
+    UnitArchetype& of(UnitKind kind) { return archetypes[static_cast<int>(kind)]; }
+    const UnitArchetype& of(UnitKind kind) const { return archetypes[static_cast<int>(kind)]; }
+
+    uint32_t getNextId() const { return nextId; }
+    void setNextId(uint32_t id) { nextId = id; }
+
+    size_t enemyCount() const;
+    size_t troopCount() const;
+};
+
+#endif
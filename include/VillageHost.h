@@ -0,0 +1,149 @@
+#ifndef VILLAGEHOST_H
+#define VILLAGEHOST_H
+
+#include "World.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Settings of one hosted village
+ */
+struct VillageConfig {
+    uint64_t seed = Rng::DEFAULT_SEED;
+    MapSize size;
+    SpawnTable waves = classicSpawnTable();
+    uint32_t tickMicros = 0;  // Tick interval; 0 runs ticks back to back
+};
+
+/**
+ * @brief Tick latency histogram: 8 linear sub-buckets per power of two of nanoseconds
+ */
+constexpr int LATENCY_SUB_BUCKETS = 8;
+constexpr int LATENCY_BUCKETS = 64 * LATENCY_SUB_BUCKETS;
+
+/**
+ * @brief Tick timings of one village, or of several merged
+ */
+struct VillageStats {
+    uint64_t ticks = 0;
+    uint64_t tickNs = 0;     // Sum of tick durations
+    uint64_t maxTickNs = 0;
+    uint64_t lagNs = 0;      // Sum of how late ticks started after they were due
+    uint64_t maxLagNs = 0;
+    uint32_t histogram[LATENCY_BUCKETS] = {};  // Tick durations
+
+    void record(uint64_t ns, uint64_t lag);
+    void merge(const VillageStats& other);
+
+    /**
+     * @brief Tick duration below which a fraction p of the ticks fall
+     *
+     * Exact to within one sub-bucket (1/8 of a power of two).
+     */
+    uint64_t percentileNs(double p) const;
+};
+
+/**
+ * @brief Host threads and placement
+ */
+struct HostOptions {
+    int threads = 0;          // 0 uses the hardware concurrency
+    bool pinThreads = false;  // Pin worker i to the i-th CPU the process may run on (Linux)
+};
+
+/**
+ * @brief Outcome of one VillageHost::run()
+ */
+struct HostReport {
+    double seconds = 0;
+    uint64_t villageTicks = 0;
+    double villageTicksPerSecond = 0;
+    uint64_t steals = 0;   // Ticks run by a worker that took the village from another
+    int threads = 0;
+    int pinned = 0;        // Workers successfully pinned to a CPU
+    VillageStats all;      // Every village's stats merged
+};
+
+/**
+ * @brief Runs many independent worlds in one process
+ *
+ * Each village is a World with its own seed, map, spawn table and tick
+ * cadence, stepped single-threaded; the parallelism is across villages.
+ * Villages start spread round-robin over the workers. A worker keeps the
+ * villages it owns in a deadline heap and moves those that fall due into
+ * its ready queue, which it serves first in, first out. A worker with
+ * nothing ready steals from the back of another worker's queue, and the
+ * stolen village then belongs to the thief. So load evens out as
+ * villages speed up or slow down.
+ *
+ * Worlds share nothing, so every village reaches the same state as it
+ * would stepped alone, whichever workers ran it. Boards are created with
+ * one thread and do not close Profiler ticks, which are process-wide.
+ */
+class VillageHost {
+private:
+    struct Village {
+        std::unique_ptr<World> world;
+        uint64_t intervalNs;
+        uint64_t dueNs;       // Host clock time the next tick is due
+        uint64_t tickLimit;   // Ticks left in this run
+        VillageStats stats;
+    };
+
+    struct Worker {
+        std::mutex mutex;                                  // Guards ready
+        std::deque<uint32_t> ready;                        // Villages due now
+        std::vector<std::pair<uint64_t, uint32_t>> timers; // (due, village) min-heap, owner only
+        uint64_t steals = 0;
+    };
+
+    HostOptions options;
+    std::vector<Village> villages;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<size_t> remaining{0};  // Villages that still have ticks to run
+    std::atomic<bool> stopping{false};
+    uint64_t stopNs = 0;               // Host clock time the run ends, 0 for no limit
+
+    void workerLoop(int index);
+    bool takeReady(int index, uint32_t& village);
+    void runTick(int index, uint32_t village);
+
+public:
+    explicit VillageHost(HostOptions options = HostOptions());
+
+    VillageHost(const VillageHost&) = delete;
+    VillageHost& operator=(const VillageHost&) = delete;
+
+    /**
+     * @brief Add a village; only between runs
+     *
+     * @return Village index
+     */
+    size_t addVillage(const VillageConfig& config);
+
+    /**
+     * @brief Run every village until it has done ticksPerVillage more ticks,
+     *        its game is over, or seconds have passed
+     *
+     * @param ticksPerVillage 0 for no tick limit
+     * @param seconds 0 for no time limit; at least one limit must be set
+     */
+    HostReport run(uint64_t ticksPerVillage, double seconds = 0);
+
+    size_t size() const { return villages.size(); }
+    int threadCount() const { return static_cast<int>(workers.size()); }
+    const World& getWorld(size_t village) const { return *villages[village].world; }
+    World& getWorld(size_t village) { return *villages[village].world; }
+
+    /**
+     * @brief Timings of a village during the last run
+     */
+    const VillageStats& getStats(size_t village) const { return villages[village].stats; }
+};
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef WAVESCHEDULER_H
+#define WAVESCHEDULER_H
+
+#include "Position.h"
+#include "Rng.h"
+#include "UnitTypes.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// How the number of groups grows from one wave of a spawn table row to the next
+enum class RampCurve : uint8_t {
+    CONSTANT,    // Every wave has the row's base group count
+    LINEAR,      // rampStep more groups each wave
+    EXPONENTIAL  // rampStep percent more groups each wave (integer arithmetic)
+};
+
+// How the followers of a group are placed around its leader
+enum class ClusterShape : uint8_t {
+    BLOB,   // Random offsets of up to spread cells in both directions
+    LINE,   // Side by side along the edge, alternating left and right of the leader
+    COLUMN  // One behind the other, from the edge into the map
+};
+
+// Map edges a row spawns from, combined as a bit mask
+enum SpawnEdge : uint8_t {
+    EDGE_TOP = 1,
+    EDGE_RIGHT = 2,
+    EDGE_BOTTOM = 4,
+    EDGE_LEFT = 8,
+    EDGE_ALL = 15
+};
+
+// Upper bound on the groups of one wave, whatever the ramp says
+constexpr uint32_t MAX_WAVE_GROUPS = 4096;
+
+/**
+ * @brief One row of a spawn table: a recurring wave of enemy groups
+ *
+ * A wave is a number of groups; each group is a leader on a random point
+ * of one of the row's edges plus, with followPercent chance, a few
+ * followers arranged in the row's cluster shape. The defaults describe the
+ * classic game: a single enemy every 30 ticks, now and then with one or
+ * two companions.
+ *
+ * Plain data of fixed-width fields, so snapshots store rows byte for byte.
+ */
+struct WaveSpec {
+    uint32_t start = 30;        // Completed tick of the first wave
+    uint32_t every = 30;        // Ticks between waves, 0 for a single wave
+    uint32_t waves = 0;         // Number of waves, 0 for no limit
+    uint32_t groups = 1;        // Groups in the first wave
+    uint32_t rampStep = 0;      // See RampCurve
+    uint32_t maxGroups = 0;     // Cap on groups per wave, 0 for MAX_WAVE_GROUPS
+    RampCurve ramp = RampCurve::CONSTANT;
+    ClusterShape shape = ClusterShape::BLOB;
+    uint8_t edges = EDGE_ALL;
+    uint8_t raiderPercent = 40;    // Leaders that are raiders; the rest are bombermen
+    uint8_t followPercent = 10;    // Groups that get followers
+    uint8_t followersMin = 1;
+    uint8_t followersMax = 2;
+    uint8_t sameKindPercent = 50;  // Followers of the leader's kind; the rest are of the other kind
+    uint8_t spread = 3;            // BLOB: largest offset from the leader
+    uint8_t padding[3] = {};
+};
+
+using SpawnTable = std::vector<WaveSpec>;
+
+/**
+ * @brief The classic spawner: the default WaveSpec alone
+ */
+SpawnTable classicSpawnTable();
+
+/**
+ * @brief Stress table: the classic trickle plus waves that ramp up to thousands of enemies
+ */
+SpawnTable siegeSpawnTable();
+
+/**
+ * @brief A row as one line of the spawn table text format
+ *
+ *   wave start=30 every=30 waves=0 groups=1 ramp=constant step=0 max=0
+ *        raiders=40 edges=trbl shape=blob follow=10 followers=1-2 same=50 spread=3
+ *
+ * parseWave() accepts any subset of the fields, in any order; missing
+ * ones keep their defaults.
+ */
+std::string formatWave(const WaveSpec& spec);
+
+/**
+ * @brief Parse a line written by formatWave()
+ *
+ * @param error If not null, receives the reason parsing failed
+ * @return false if the line is not a valid wave
+ */
+bool parseWave(const std::string& line, WaveSpec& spec, std::string* error = nullptr);
+
+/**
+ * @brief Check that a row holds only values parseWave() can produce
+ *
+ * Rows read as bytes (snapshots) are checked with this before use.
+ */
+bool isValidWave(const WaveSpec& spec);
+
+/**
+ * @brief Load a spawn table by preset name ("classic", "siege") or from a file
+ *
+ * A file holds one wave line per row; blank lines and lines starting
+ * with '#' are ignored.
+ *
+ * @param error If not null, receives the reason a load failed
+ */
+bool loadSpawnTable(const std::string& source, SpawnTable& table, std::string* error = nullptr);
+
+/**
+ * @brief Rectangle enemies spawn on the edges of, inclusive
+ */
+struct SpawnArea {
+    int left, top, right, bottom;
+};
+
+/**
+ * @brief Enemies of the waves due at one tick, split by kind
+ *
+ * Indexed by a kind's place in EnemyKinds (EnemyKinds::indexOf). order[k][i]
+ * is the place of unit i among all units of the batch, so ids can be
+ * handed out in spawn order once the batch is complete.
+ */
+struct WaveBatch {
+    std::vector<Position> positions[EnemyKinds::size];
+    std::vector<uint32_t> order[EnemyKinds::size];
+    uint32_t size = 0;
+
+    void clear();
+};
+
+/**
+ * @brief Turns a spawn table into enemy batches
+ *
+ * Whether a row spawns at a tick and how many groups it spawns are pure
+ * functions of the tick, so the scheduler has no state to save beyond
+ * the table itself. Every due wave of a tick is generated into one batch
+ * that the board inserts in bulk; the batch buffers are kept between
+ * ticks and only grow.
+ */
+class WaveScheduler {
+private:
+    SpawnTable table;
+    WaveBatch batch;
+
+    void generate(const WaveSpec& spec, uint32_t groups, RngStream& random, const SpawnArea& area);
+
+public:
+    explicit WaveScheduler(SpawnTable table = classicSpawnTable());
+
+    /**
+     * @brief Number of groups in wave n (0-based) of a row, after ramp and cap
+     */
+    static uint32_t groupsInWave(const WaveSpec& spec, uint64_t wave);
+
+    /**
+     * @brief Generate the enemies of every wave due when a tick completes
+     *
+     * @param completed Ticks completed once the current update is done (1 on the first update)
+     * @param random Spawner stream of the current tick; rows draw from it in table order
+     * @param area Spawn rectangle
+     * @return The batch, empty if no wave is due; valid until the next call
+     */
+    const WaveBatch& spawnDue(uint64_t completed, RngStream random, const SpawnArea& area);
+
+    const SpawnTable& getTable() const { return table; }
+    void setTable(SpawnTable rows) { table = std::move(rows); }
+};
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "Board.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Headless simulation driver
+ *
+ * Owns the Board and advances it in fixed ticks. World performs no I/O:
+ * front-ends (the terminal game, benchmarks, tools) read state through
+ * getBoard() and decide themselves when to step and when to draw.
+ */
+class World {
+private:
+    Board board;
+
+public:
+    /**
+     * @brief Create a world whose randomness is fully determined by a seed
+     *
+     * @param seed World seed
+     * @param threads Workers for the parallel tick (0 = hardware concurrency);
+     *        the result is the same for any value
+     * @param size Map dimensions
+     * @param spawnTable Enemy waves (see WaveScheduler.h)
+     */
+    explicit World(uint64_t seed = Rng::DEFAULT_SEED, int threads = 0, MapSize size = MapSize(),
+                   SpawnTable spawnTable = classicSpawnTable());
+
+    /**
+     * @brief Advance the simulation by a number of fixed ticks
+     *
+     * Stops early once the game is over.
+     *
+     * @param n Number of ticks to run
+     * @return Number of ticks actually simulated
+     */
+    int step(int n = 1);
+
+    /**
+     * @brief Apply a single player command
+     *
+     * Commands use the same letters InputManager produces:
+     * U/D/L/R move, W/M/E build, C collects, A/B train troops.
+     *
+     * @param command Command character
+     * @return true if the command was recognized and succeeded
+     */
+    bool handleCommand(char command);
+
+    /**
+     * @brief Number of ticks simulated (including those before a snapshot was taken)
+     */
+    uint64_t getTick() const { return board.getTick(); }
+
+    /**
+     * @brief Write the full world state to a binary snapshot file
+     *
+     * @return false if the file could not be written
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Create a world from a snapshot file written by save()
+     *
+     * The file is mapped into memory and its arrays copied straight into
+     * the board. The loaded world continues exactly as the saved one would.
+     *
+     * @param path Snapshot file
+     * @param threads Workers for the parallel tick (0 = hardware concurrency)
+     * @param error If not null, receives the reason a load failed
+     * @return The world, or nullptr if the file is missing, damaged or of another version
+     */
+    static std::unique_ptr<World> load(const std::string& path, int threads = 0, std::string* error = nullptr);
+
+    /**
+     * @brief Create a world from snapshot bytes in memory (e.g. an observer stream keyframe)
+     *
+     * @return The world, or nullptr if the bytes are damaged or of another version
+     */
+    static std::unique_ptr<World> fromSnapshot(const char* data, size_t size, int threads = 0,
+                                               std::string* error = nullptr);
+
+    /**
+     * @brief 64-bit FNV-1a hash of the snapshot of the current state
+     *
+     * Two worlds with equal digests are, for all practical purposes, in the
+     * same state; used to check that replays do not diverge.
+     */
+    uint64_t digest() const;
+
+    bool isGameOver() const { return board.isGameOver(); }
+    Board& getBoard() { return board; }
+    const Board& getBoard() const { return board; }
+};
+
+#endif
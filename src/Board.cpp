@@ -1,323 +1,235 @@
 #include "Board.h"
-#include "Raider.h"
-#include "Bomberman.h"
-#include <iostream>
+#include "EnemySystem.h"
+#include "TroopSystem.h"
+#include "UnitTypes.h"
+#include "Profiler.h"
 #include <algorithm>
 #include <memory>
 #include <utility>
-#include <memory>
-#include <random>
-#include <unistd.h>
-#include <termios.h>
-#include <climits>  // For INT_MAX
 
 using namespace std;
 
+namespace {
+// Town Hall column on the default map; larger maps keep it at the same relative spot
+const int DEFAULT_TOWNHALL_X = 80;
+
+int townhallX(int width) {
+    return DEFAULT_TOWNHALL_X * width / MapSize::DEFAULT_WIDTH;
+}
+}
+
 /* Constructor for Board class
  * Initializes:
- * - Player at starting position (margin+2, height/2)
- * - Townhall at (80, height/2)
- * - Left text area for displaying game stats
- * - Spawn counter and rate for enemies
+ * - Map dimensions, clamped to the supported range
+ * - Townhall at (80, height/2) on the default map, at the same relative
+ *   column on other widths
+ * - Player at starting position (margin+2, height/2) on the default map,
+ *   at the same offset from the townhall otherwise
+ * - Wave scheduler for the given spawn table (the classic trickle by default)
  * - Game over flag set to false
- * - Enemy type counters
+ * - Unit counters
+ * - Occupancy grid with the townhall footprint
+ * - Flow fields toward the townhall for both enemy types, seeded on the
+ *   first tick so that placing a scenario's walls does no repairs, then
+ *   searched each tick as far as the enemies need
+ * - Random streams derived from the given seed
+ * - Worker pool for the parallel tick (0 threads = hardware concurrency)
+ * - Unit pools and per-tick scratch buffers sized for unitCapacity units
+ *   per kind, so ticks below that population do not allocate
  */
-Board::Board() : player(margin + 2, height / 2), 
-                 townhall(80, height / 2),
-                 leftTexts(height - 2, string(margin - 1, ' ')),
-                 spawnCounter(0),
-                 spawnRate(30),
-                 gameOver(false),
-                 raiderCount(0),
-                 bombermanCount(0) {}
-
-/* Draws a building on the console
- * Handles both bordered buildings (walls, mines, collectors) and simple icons
- * Uses ANSI escape codes for positioning
+Board::Board(uint64_t seed, int threads, MapSize size, SpawnTable spawnTable) : width(size.clamped().width),
+                 height(size.clamped().height),
+                 player(max(margin + 2, townhallX(width) - (DEFAULT_TOWNHALL_X - margin - 2)), height / 2),
+                 buildings(TownHall(townhallX(width), height / 2)),
+                 occupancy(width, height),
+                 avoidWallsField(width, height, margin + 1, 1, width - 2, height - 2,
+                                 FlowFieldMode::AVOID_WALLS),
+                 wallCostField(width, height, margin + 1, 1, width - 2, height - 2,
+                               FlowFieldMode::WALL_COST),
+                 enemyView(width, height, margin + 1, 1, width - 2, height - 2),
+                 rng(seed),
+                 workers(threads),
+                 waves(std::move(spawnTable)),
+                 gameOver(false) {
+    registerBuilding(buildings.townhallHandle());
+
+    units.reserve(unitCapacity);
+    enemyView.positions.reserve(EnemyKinds::size * unitCapacity);
+    enemyView.health.reserve(EnemyKinds::size * unitCapacity);
+    enemyView.troopPositions.reserve(TroopKinds::size * unitCapacity);
+    troopTargets.reserve(unitCapacity);
+    buildingHits.resize(workers.size());
+    for (auto& buffer : buildingHits) buffer.reserve(unitCapacity);
+    troopScratch.resize(workers.size());
+}
+
+/* Assigns a fresh id to a stored building and stamps its footprint
+ * into the occupancy grid
  */
-void Board::drawBuilding(const Building& building) const {
-    int startX = building.getPosition().x;
-    int startY = building.getPosition().y;
-    string icon = building.getIcon();
-
-    if (building.Border()) {
-        int sizeX = building.getSizeX();
-        int sizeY = building.getSizeY();
-
-        // Draw top border
-        cout << "\033[" << startY << ";" << startX << "H+";
-        for (int i = 0; i < sizeX - 2; ++i) cout << "-";
-        cout << "+";
-
-        // Draw middle rows with icon centered
-        for (int j = 1; j < sizeY - 1; ++j) {
-            cout << "\033[" << startY + j << ";" << startX << "H|";
-            for (int i = 1; i < sizeX - 1; ++i) {
-                if (i == sizeX/2 && j == sizeY/2) {
-                    cout << icon;
-                    if (i < sizeX - 2) ++i;  // Skip next position if icon is 2 chars wide
-                } else {
-                    cout << " ";
-                }
-            }
-            cout << "|";
-        }
+void Board::registerBuilding(BuildingHandle handle) {
+    Building& building = *buildings.get(handle);
+    building.setId(nextBuildingId++);
+    occupancy.place(building, handle.kind, handle.slot);
+}
 
-        // Draw bottom border
-        cout << "\033[" << startY + sizeY - 1 << ";" << startX << "H+";
-        for (int i = 0; i < sizeX - 2; ++i) cout << "-";
-        cout << "+";
-    } else {
-        // Simple icon without border
-        cout << "\033[" << startY << ";" << startX << "H" << icon;
-    }
+/* Starts both flow fields over from the current walls
+ * and searches them as far as the current enemies need
+ */
+void Board::buildFlowFields() {
+    avoidWallsField.build(occupancy, buildings.townhall);
+    wallCostField.build(occupancy, buildings.townhall);
+    fieldsBuilt = true;
+    settleFlowFields();
+}
+
+/* Extends each flow field's search to the enemies that follow it
+ * The fields are independent and are searched on two workers when the pool has them
+ */
+void Board::settleFlowFields() {
+    FlowField* fields[2] = { &avoidWallsField, &wallCostField };
+    workers.parallelFor(2, 1, [&](size_t begin, size_t end, int) {
+        for (size_t i = begin; i < end; ++i) {
+            forEachKind(EnemyKinds(), [&](auto kind) {
+                if (&fieldFor(kind) == fields[i]) fields[i]->settle(units.of(kind).position);
+            });
+        }
+    });
 }
 
-/* Checks if two buildings are colliding by comparing their bounding boxes
- * Returns true if buildings overlap, false otherwise
+/* Repairs both flow fields around a wall that was placed or destroyed
+ * A wall affects the cells within one step of it; nothing to do before
+ * the fields are first built
  */
-bool Board::areBuildingsColliding(const Building& b1, const Building& b2) const {
-    // Calculate bounding boxes for both buildings
-    int x1_min = b1.getPosition().x;
-    int y1_min = b1.getPosition().y;
-    int x1_max = x1_min + b1.getSizeX();
-    int y1_max = y1_min + b1.getSizeY();
-
-    int x2_min = b2.getPosition().x;
-    int y2_min = b2.getPosition().y;
-    int x2_max = x2_min + b2.getSizeX();
-    int y2_max = y2_min + b2.getSizeY();
-
-    // Check for non-overlapping conditions
-    bool noOverlap = x1_max <= x2_min || x2_max <= x1_min ||
-                     y1_max <= y2_min || y2_max <= y1_min;
-
-    return !noOverlap;  // Return true if buildings overlap
+void Board::onWallChanged(const Position& pos) {
+    if (!fieldsBuilt) return;
+    avoidWallsField.repair(occupancy, pos.x - 1, pos.y - 1, pos.x + 1, pos.y + 1);
+    wallCostField.repair(occupancy, pos.x - 1, pos.y - 1, pos.x + 1, pos.y + 1);
 }
 
-/* Checks if a specific position is occupied by any building
+/* Returns the flow field built for an enemy kind's wall handling (UnitStats::fieldMode) */
+const FlowField& Board::fieldFor(UnitKind kind) const {
+    return unitStats(kind).fieldMode == FlowFieldMode::AVOID_WALLS ? avoidWallsField : wallCostField;
+}
+
+/* Checks if a specific position is occupied by a wall
  * Can ignore a specific building (useful when checking movement for existing buildings)
  */
 bool Board::isPositionOccupied(const Position& pos, const Building* ignore) const {
-    for (const auto& wall : walls) {
-        if (ignore != &wall &&
-            areBuildingsColliding(Building(pos.x, pos.y, 1, 1, 0, 0, 0, 0, "", false), wall)) {
-            return true;
-        }
-    }
-    return false;
+    Occupant cell = occupancy.at(pos.x, pos.y);
+    return cell.kind == BuildingKind::WALL && (!ignore || ignore->getId() != cell.id);
+}
+
+/* Checks that a cell lies on the map
+ * Positions read from snapshots and observer streams are checked before use
+ */
+bool Board::isOnMap(const Position& pos) const {
+    return pos.x >= 0 && pos.x < width && pos.y >= 0 && pos.y < height;
+}
+
+/* Checks that a building's whole footprint lies on the map */
+bool Board::isOnMap(const Building& building) const {
+    const Position& pos = building.getPosition();
+    return pos.x >= 0 && pos.y >= 0 && building.getSizeX() <= width - pos.x &&
+           building.getSizeY() <= height - pos.y;
 }
 
 /* Checks if a building can be placed at its current location
- * Verifies collisions with all other buildings except the one being ignored
+ * Verifies its footprint is free of all other buildings except the one being ignored
  */
 bool Board::CanBuild(const Building* building, const Building* ignore) const {
-    // Check against walls
-    for (const auto& wall : walls) {
-        if (ignore != &wall && areBuildingsColliding(*building, wall)) return false;
-    }
-    
-    // Check against gold mines
-    for (const auto& mine : goldMines) {
-        if (ignore != &mine && areBuildingsColliding(*building, mine)) return false;
-    }
-    
-    // Check against elixir collectors
-    for (const auto& collector : elixirCollectors) {
-        if (ignore != &collector && areBuildingsColliding(*building, collector)) return false;
-    }
-    
-    // Check against townhall
-    if (areBuildingsColliding(*building, townhall)) return false;
-
-    return true;  // No collisions found
+    const Position& pos = building->getPosition();
+    return occupancy.isAreaFree(pos.x, pos.y, building->getSizeX(), building->getSizeY(),
+                                ignore ? ignore->getId() : 0);
 }
 
-/* Spawns enemies at random positions around the map edges
- * Uses a counter and spawn rate to control frequency
- * Enemies spawn from all four edges with varied patterns
+/* Spawns the enemies of every wave due this tick
+ * The wave scheduler turns the spawn table into a single batch, drawing from
+ * the spawner's own stream; the batch goes into each enemy archetype with one
+ * bulk insert, and ids are handed out in spawn order
  */
-void Board::spawnEnemy() {
-    spawnCounter++;
-    if (spawnCounter >= spawnRate) {
-        spawnCounter = 0;
-        
-        // Random number generation setup
-        static random_device rd;
-        static mt19937 gen(rd());
-        uniform_int_distribution<> edge_dis(0, 3);  // 0=top, 1=right, 2=bottom, 3=left
-        uniform_int_distribution<> type_dis(0, 9);  // For enemy type (0-9)
-        
-        // Distributions for different edges - defined outside the switch
-        uniform_int_distribution<> x_dis(margin + 1, width - 2);
-        uniform_int_distribution<> y_dis(1, height - 2);
-        
-        // Determine spawn position (random edge)
-        int x, y;
-        int edge = edge_dis(gen);
-        
-        switch (edge) {
-            case 0: // Top edge
-                x = x_dis(gen);
-                y = 1;
-                break;
-                
-            case 1: // Right edge
-                x = width - 2;
-                y = y_dis(gen);
-                break;
-                
-            case 2: // Bottom edge
-                x = x_dis(gen);
-                y = height - 2;
-                break;
-                
-            case 3: // Left edge
-                x = margin + 1;
-                y = y_dis(gen);
-                break;
-        }
-        
-        // Determine enemy type: 0-3 for Raiders (40%), 4-9 for Bombermen (60%)
-        int enemyTypeRoll = type_dis(gen);
-        if (enemyTypeRoll < 4) {
-            enemies.push_back(make_unique<Raider>(x, y));
-            raiderCount++;
-        } else {
-            enemies.push_back(make_unique<Bomberman>(x, y));
-            bombermanCount++;
-        }
-        
-        // Occasionally spawn groups of enemies (10% chance)
-        if (type_dis(gen) < 1) {
-            // Spawn a small cluster of 1-2 additional enemies around the same point
-            int extraEnemies = 1 + (rand() % 2); // Simple random 1-2 to avoid distribution scope issues
-            
-            for (int i = 0; i < extraEnemies; i++) {
-                // Generate small random offsets (-3 to +3)
-                int offsetX = rand() % 7 - 3;
-                int offsetY = rand() % 7 - 3;
-                
-                int groupX = x + offsetX;
-                int groupY = y + offsetY;
-                
-                // Keep within bounds
-                if (groupX < margin + 1) groupX = margin + 1;
-                if (groupX > width - 2) groupX = width - 2;
-                if (groupY < 1) groupY = 1;
-                if (groupY > height - 2) groupY = height - 2;
-                
-                // 50/50 chance of same or different enemy type
-                int groupTypeRoll = rand() % 10; // Simple random 0-9
-                
-                if (groupTypeRoll < 5) {
-                    // Same type as original
-                    if (enemyTypeRoll < 4) {
-                        enemies.push_back(make_unique<Raider>(groupX, groupY));
-                        raiderCount++;
-                    } else {
-                        enemies.push_back(make_unique<Bomberman>(groupX, groupY));
-                        bombermanCount++;
-                    }
-                } else {
-                    // Different type as original
-                    if (enemyTypeRoll < 4) {
-                        enemies.push_back(make_unique<Bomberman>(groupX, groupY));
-                        bombermanCount++;
-                    } else {
-                        enemies.push_back(make_unique<Raider>(groupX, groupY));
-                        raiderCount++;
-                    }
-                }
-            }
-        }
-    }
+void Board::spawnWaves() {
+    SpawnArea area{ margin + 1, 1, width - 2, height - 2 };
+    const WaveBatch& batch = waves.spawnDue(rng.getTick() + 1, rng.stream(Rng::SPAWNER), area);
+    if (batch.size == 0) return;
+
+    uint32_t firstId = units.takeIds(batch.size);
+    forEachKind(EnemyKinds(), [&](auto kind) {
+        const int k = EnemyKinds::indexOf(kind);
+        units.of(kind).addBatch(firstId, batch.order[k], batch.positions[k]);
+        unitCounters[static_cast<int>(kind())] += static_cast<int>(batch.positions[k].size());
+    });
+    PROFILE_COUNT(Metric::UNITS_SPAWNED, batch.size);
 }
 
 /* Updates all enemies' positions and checks for game over condition
  * Also removes destroyed buildings
  */
 void Board::updateEnemies() {
-    for (auto& enemy : enemies) {
-        if (enemy->update(townhall.getPosition(), walls, goldMines, elixirCollectors, townhall)) {
-            gameOver = true;  // Townhall was destroyed
-            return;           // No need to continue; game is over
+    if (!fieldsBuilt) buildFlowFields();
+    else settleFlowFields();
+
+    forEachKind(EnemyKinds(), [&](auto kind) {
+        if (gameOver) return;  // No need to continue; game is over
+        if (updateEnemyArchetype(units.of(kind), fieldFor(kind), rng, buildings, workers, buildingHits)) {
+            gameOver = true;   // Townhall was destroyed
         }
-    }
+    });
+    if (gameOver) return;
 
-    // Remove destroyed buildings
-    walls.erase(remove_if(walls.begin(), walls.end(), 
-        [](const Wall& w) { return w.getHealth() <= 0; }), walls.end());
-    goldMines.erase(remove_if(goldMines.begin(), goldMines.end(), 
-        [](const GoldMine& m) { return m.getHealth() <= 0; }), goldMines.end());
-    elixirCollectors.erase(remove_if(elixirCollectors.begin(), elixirCollectors.end(), 
-        [](const ElixirCollector& e) { return e.getHealth() <= 0; }), elixirCollectors.end());
+    // Remove the buildings destroyed this tick, releasing their cells in the
+    // occupancy grid. Nothing is scanned when nothing died.
+    if (buildings.destroyed.empty()) return;
+    destroyedWalls.clear();
+    for (const BuildingHandle& handle : buildings.destroyed) {
+        const Building* building = buildings.get(handle);
+        if (!building || handle.kind == BuildingKind::TOWNHALL) continue;
+        occupancy.remove(*building);
+        if (handle.kind == BuildingKind::WALL) destroyedWalls.push_back(building->getPosition());
+        buildings.remove(handle);
+        PROFILE_COUNT(Metric::BUILDINGS_ERASED, 1);
+    }
+    buildings.destroyed.clear();
+    for (const auto& pos : destroyedWalls) onWallChanged(pos);
 }
 
 /* Updates all troops' behavior - attacks enemies and removes dead troops
- * Troops will attack the first enemy they encounter within range,
- * and move strategically based on their attack range
+ * Enemy positions and health are gathered once per tick and the positions
+ * indexed in a spatial hash, so each troop only looks at the buckets around
+ * it for the closest live enemy in range. Troops with nobody in range follow
+ * a distance field searched once from all enemies, around buildings, toward
+ * the nearest one; troops beyond the search use the spatial hash instead.
+ * Damage accumulates in the gathered
+ * health and is written back once, before dead enemies are compacted away
  */
 void Board::updateTroops() {
     // Check for dead troops and remove them
-    troops.erase(remove_if(troops.begin(), troops.end(), 
-        [](const unique_ptr<Troop>& troop) { return !troop->isAlive(); }), troops.end());
-    
-    // For each troop, find an enemy to attack
-    for (auto& troop : troops) {
-        bool hasAttacked = false;
-        
-        // Try to attack any enemy within range
-        for (auto& enemy : enemies) {
-            // Create a shared_ptr that observes the unique_ptr (doesn't take ownership)
-            shared_ptr<Enemy> sharedEnemy(enemy.get(), [](Enemy*){});
-            
-            if (troop->attack(sharedEnemy)) {
-                hasAttacked = true;
-                break;  // Only attack one enemy per update
-            }
-        }
-        
-        // If troop didn't attack, consider moving toward nearest enemy
-        if (!hasAttacked && !enemies.empty()) {
-            // Find the closest enemy
-            Position closestEnemyPos;
-            int closestDistance = INT_MAX;
-            
-            for (auto& enemy : enemies) {
-                Position troopPos = troop->getPosition();
-                Position enemyPos = enemy->getPosition();
-                
-                int distance = abs(troopPos.x - enemyPos.x) + abs(troopPos.y - enemyPos.y);
-                
-                if (distance < closestDistance) {
-                    closestDistance = distance;
-                    closestEnemyPos = enemyPos;
-                }
-            }
-            
-            // Only move if needed based on troop type and range
-            if (closestDistance < INT_MAX) {
-                // For ranged troops like archers, maintain optimal distance if possible
-                int optimalDistance = troop->getRange();
-                
-                // If the troop is an archer and already at a good range, don't move
-                bool isArcher = dynamic_cast<Archer*>(troop.get()) != nullptr;
-                
-                if (isArcher && closestDistance <= optimalDistance && closestDistance > 1) {
-                    // Archer is at a good range to attack, don't move closer
-                    // We'll let archer update try to attack again next turn
-                } else {
-                    // For non-archers or archers too far away, move toward enemy
-                    troop->moveTowards(closestEnemyPos);
-                }
-            }
-        }
-    }
+    forEachKind(TroopKinds(), [&](auto kind) { units.of(kind).removeDead(); });
+
+    enemyView.gather(units, occupancy);
+    forEachKind(TroopKinds(), [&](auto kind) {
+        updateTroopArchetype(units.of(kind), enemyView, troopTargets, workers, troopScratch);
+    });
     
-    // Remove dead enemies
-    enemies.erase(remove_if(enemies.begin(), enemies.end(), 
-        [](const unique_ptr<Enemy>& enemy) { return enemy->getHealth() <= 0; }), enemies.end());
+    // Apply the tick's damage once, then remove dead enemies
+    enemyView.scatter(units);
+    forEachKind(EnemyKinds(), [&](auto kind) { units.of(kind).removeDead(); });
+}
+
+/* Adds a unit to the board and updates the per-kind counters */
+void Board::addUnit(UnitKind kind, int x, int y) {
+    units.spawn(kind, Position(x, y));
+    unitCounters[static_cast<int>(kind)]++;
+}
+
+/* Places a wall for free, bypassing cost and the instance limit
+ * Used to set up scenarios; returns false if the cell is not free
+ */
+bool Board::addWall(int x, int y) {
+    Wall wall(x, y);
+    if (!CanBuild(&wall)) return false;
+    registerBuilding(buildings.add(wall));
+    onWallChanged(wall.getPosition());
+    return true;
 }
 
 /* Attempts to move player in specified direction
@@ -348,13 +260,14 @@ bool Board::placeWall() {
     Wall newWall(pos.x, pos.y);
 
     if (!CanBuild(&newWall)) return false;
-    if (walls.size() >= static_cast<size_t>(newWall.getMaxInstances())) return false;
+    if (buildings.walls.size() >= static_cast<size_t>(newWall.getMaxInstances())) return false;
 
     if (player.getResources().gold >= newWall.getCostGold() && 
         player.getResources().elixir >= newWall.getCostElixir()) {
         player.getResources().spendGold(newWall.getCostGold());
         player.getResources().spendElixir(newWall.getCostElixir());
-        walls.push_back(newWall);
+        registerBuilding(buildings.add(newWall));
+        onWallChanged(pos);
         return true;
     }
 
@@ -372,11 +285,14 @@ bool Board::placeGoldMine() {
     GoldMine mineToPlace(centerX, centerY);
 
     if (!CanBuild(&mineToPlace)) return false;
-    if (goldMines.size() >= static_cast<size_t>(newMine.getMaxInstances())) return false;
+    if (buildings.goldMines.size() >= static_cast<size_t>(newMine.getMaxInstances())) return false;
 
     if (player.getResources().elixir >= newMine.getCostElixir()) {
         player.getResources().spendElixir(newMine.getCostElixir());
-        goldMines.push_back(mineToPlace);
+        mineToPlace.startFilling(rng.getTick());
+        BuildingHandle handle = buildings.add(mineToPlace);
+        registerBuilding(handle);
+        scheduleFull(handle);
         return true;
     }
 
@@ -394,31 +310,39 @@ bool Board::placeElixirCollector() {
     ElixirCollector collectorToPlace(centerX, centerY);
 
     if (!CanBuild(&collectorToPlace)) return false;
-    if (elixirCollectors.size() >= static_cast<size_t>(newCollector.getMaxInstances())) return false;
+    if (buildings.elixirCollectors.size() >= static_cast<size_t>(newCollector.getMaxInstances())) return false;
 
     if (player.getResources().gold >= newCollector.getCostGold()) {
         player.getResources().spendGold(newCollector.getCostGold());
-        elixirCollectors.push_back(collectorToPlace);
+        collectorToPlace.startFilling(rng.getTick());
+        BuildingHandle handle = buildings.add(collectorToPlace);
+        registerBuilding(handle);
+        scheduleFull(handle);
         return true;
     }
 
     return false;
 }
 
-/* Train an archer near the player's position
- * Requires 30 elixir to train
- * Finds valid position around player to place the archer
+/* Trains a troop next to the player
+ * The cost and the name in the status message come from the kind's
+ * UnitType; the troop goes on the first valid cell around the player
  */
-bool Board::trainArcher() {
-    const int archerCost = 30;
+bool Board::trainTroop(UnitKind kind) {
+    const UnitStats& stats = unitStats(kind);
+    Resources& resources = player.getResources();
     
     // Check if player has enough resources
-    if (player.getResources().elixir < archerCost) {
-        cout << "Not enough elixir to train an Archer! (Need " << archerCost << ")" << endl;
+    if (resources.gold < stats.costGold) {
+        statusMessage = "Need " + to_string(stats.costGold) + " gold for " + stats.label;
+        return false;
+    }
+    if (resources.elixir < stats.costElixir) {
+        statusMessage = "Need " + to_string(stats.costElixir) + " elixir for " + stats.label;
         return false;
     }
     
-    // Get position adjacent to player for the archer
+    // Get position adjacent to player for the troop
     Position playerPos = player.getPosition();
     
     // Check adjacent positions
@@ -431,235 +355,112 @@ bool Board::trainArcher() {
             // Check if position is valid
             if (troopPos.x >= margin && troopPos.x < width - 2 && 
                 troopPos.y > 0 && troopPos.y < height - 2) {
-                // Create and add archer at valid position
-                auto archer = make_unique<Archer>(troopPos.x, troopPos.y);
-                troops.push_back(std::move(archer));
-                
-                // Increment archer count
-                archerCount++;
+                addUnit(kind, troopPos.x, troopPos.y);
                 
                 // Deduct resources
-                player.getResources().elixir -= archerCost;
-                cout << "Trained an Archer for " << archerCost << " elixir!" << endl;
+                resources.gold -= stats.costGold;
+                resources.elixir -= stats.costElixir;
+                statusMessage = string("Trained ") + stats.label;
                 return true;
             }
         }
     }
     
-    cout << "No valid position to place an Archer!" << endl;
+    statusMessage = string("No room for ") + stats.label;
     return false;
 }
 
+/* Train an archer near the player's position (cost: see Archer.h) */
+bool Board::trainArcher() {
+    return trainTroop(UnitKind::ARCHER);
+}
+
+/* Train a barbarian near the player's position (cost: see Barbarian.h) */
+bool Board::trainBarbarian() {
+    return trainTroop(UnitKind::BARBARIAN);
+}
+
 /* Collects resources from buildings player is currently standing on
- * Only collects from one building of each type per call
+ * Only collects from one building of each type per call; a collected
+ * generator starts refilling and gets a new "became full" event
  */
 void Board::collectResources() {
     Position pos = player.getPosition();
 
     // Check gold mines
-    for (auto& mine : goldMines) {
+    for (size_t i = 0; i < buildings.goldMines.size(); ++i) {
+        GoldMine& mine = buildings.goldMines[i];
         Position bPos = mine.getPosition();
         if (pos.x >= bPos.x && pos.x < bPos.x + mine.getSizeX() &&
             pos.y >= bPos.y && pos.y < bPos.y + mine.getSizeY()) {
-            int collected = mine.collect();
+            int collected = mine.collect(rng.getTick());
             if (collected > 0) {
                 player.getResources().gold += collected;
+                scheduleFull(BuildingHandle{BuildingKind::GOLD_MINE, buildings.goldMines.handleAt(i)});
                 break;  // Only collect from one mine at a time
             }
         }
     }
 
     // Check elixir collectors
-    for (auto& collector : elixirCollectors) {
+    for (size_t i = 0; i < buildings.elixirCollectors.size(); ++i) {
+        ElixirCollector& collector = buildings.elixirCollectors[i];
         Position bPos = collector.getPosition();
         if (pos.x >= bPos.x && pos.x < bPos.x + collector.getSizeX() &&
             pos.y >= bPos.y && pos.y < bPos.y + collector.getSizeY()) {
-            int collected = collector.collect();
+            int collected = collector.collect(rng.getTick());
             if (collected > 0) {
                 player.getResources().elixir += collected;
+                scheduleFull(BuildingHandle{BuildingKind::ELIXIR_COLLECTOR, buildings.elixirCollectors.handleAt(i)});
                 break;  // Only collect from one collector at a time
             }
         }
     }
 }
 
-/* Updates resource production for all resource-generating buildings */
-void Board::updateResources() {
-    for (auto& mine : goldMines) mine.update();
-    for (auto& collector : elixirCollectors) collector.update();
+/* Queues the tick at which a generator will be full */
+void Board::scheduleFull(BuildingHandle generator) {
+    const ResourceGenerator* building = static_cast<const ResourceGenerator*>(buildings.get(generator));
+    fullEvents.push(ResourceFullEvent{building->fullTick(), generator});
 }
 
-/* Train a barbarian near the player's position
- * Requires 25 gold to train
- * Finds valid position around player to place the barbarian
+/* Shows the full icon of every generator that fills up during this tick
+ * Amounts are derived from the tick on demand, so only generators with a
+ * due event are touched; events of destroyed or re-collected generators
+ * no longer match and are dropped
  */
-bool Board::trainBarbarian() {
-    const int barbarianCost = 25;
-    
-    // Check if player has enough resources
-    if (player.getResources().gold < barbarianCost) {
-        cout << "Not enough gold to train a Barbarian! (Need " << barbarianCost << ")" << endl;
-        return false;
-    }
-    
-    // Get position adjacent to player for the barbarian
-    Position playerPos = player.getPosition();
-    
-    // Check adjacent positions
-    for (int dx = -1; dx <= 1; dx++) {
-        for (int dy = -1; dy <= 1; dy++) {
-            if (dx == 0 && dy == 0) continue; // Skip player's position
-            
-            Position troopPos(playerPos.x + dx, playerPos.y + dy);
-            
-            // Check if position is valid
-            if (troopPos.x >= margin && troopPos.x < width - 2 && 
-                troopPos.y > 0 && troopPos.y < height - 2) {
-                // Create and add barbarian at valid position
-                auto barbarian = make_unique<Barbarian>(troopPos.x, troopPos.y);
-                troops.push_back(std::move(barbarian));
-                
-                // Increment barbarian count
-                barbarianCount++;
-                
-                // Deduct resources
-                player.getResources().gold -= barbarianCost;
-                cout << "Trained a Barbarian for " << barbarianCost << " gold!" << endl;
-                return true;
-            }
-        }
+void Board::updateResources() {
+    const uint64_t completed = rng.getTick() + 1;
+    while (!fullEvents.empty() && fullEvents.top().tick <= completed) {
+        ResourceFullEvent event = fullEvents.top();
+        fullEvents.pop();
+        ResourceGenerator* generator = static_cast<ResourceGenerator*>(buildings.get(event.generator));
+        if (generator && generator->fullTick() == event.tick) generator->showFull();
     }
-    
-    cout << "No valid position to place a Barbarian!" << endl;
-    return false;
 }
 
 /* Main game update function - handles enemy spawning, movement, and resource updates */
 void Board::update() {
     if (gameOver) return;
-    spawnEnemy();
-    updateEnemies();
-    updateTroops();  // Update troops behavior
-    updateResources();
-}
-
-/* Renders the entire game state including:
- * - Borders and UI
- * - All buildings
- * - Enemies
- * - Troops
- * - Player
- * - Game over message if applicable
- */
-void Board::render() {
-    system("clear");
-    renderTopBorder();
-    renderMiddle();
-    renderBottomBorder();
-
-    // Draw all game objects
-    drawBuilding(townhall);
-    for (const auto& wall : walls) drawBuilding(wall);
-    for (const auto& mine : goldMines) drawBuilding(mine);
-    for (const auto& collector : elixirCollectors) drawBuilding(collector);
-
-    // Draw enemies
-    for (const auto& enemy : enemies) {
-        cout << "\033[" << enemy->getPosition().y << ";" << enemy->getPosition().x << "H";
-        cout << enemy->getIcon();
-    }
-    
-    // Draw troops
-    for (const auto& troop : troops) {
-        cout << "\033[" << troop->getPosition().y << ";" << troop->getPosition().x << "H";
-        cout << troop->getIcon();
-    }
-
-    // Draw player
-    cout << "\033[" << player.getPosition().y << ";" << player.getPosition().x << "H";
-    cout << player.getIcon();
-
-    // Game over handling
-    if (gameOver) {
-        string message = "GAME OVER - Town Hall Destroyed!";
-        cout << "\033[" << height/2 << ";" << (width - message.length())/2 << "H";
-        cout << message;
-        cout << "\033[" << height << ";0H";
-        exit(0);
-    }
-}
-
-/* Renders the top border of the game UI with margin separator */
-void Board::renderTopBorder() const {
-    cout << "+";
-    for (int x = 1; x < width - 1; x++) {
-        cout << (x == margin ? "+" : "-");
-    }
-    cout << "+" << endl;
-}
-
-/* Renders the bottom border of the game UI with margin separator */
-void Board::renderBottomBorder() const {
-    cout << "+";
-    for (int x = 1; x < width - 1; x++) {
-        cout << (x == margin ? "+" : "-");
-    }
-    cout << "+" << endl;
-}
-
-/* Renders the middle section of the game UI including:
- * - Resource counts
- * - Building counts
- * - Townhall health
- * - Enemy count
- * - Troop counts
- */
-void Board::renderMiddle() const {
-    for (int y = 1; y < height - 1; y++) {
-        cout << "|";
-
-        // Display various game stats in the left margin
-        if (y == 1) {
-            string line = "Gold = " + to_string(player.getResources().gold);
-            cout << line << string(margin - 1 - line.length(), ' ');
-        } else if (y == 2) {
-            string line = "Elixir = " + to_string(player.getResources().elixir);
-            cout << line << string(margin - 1 - line.length(), ' ');
-        } else if (y == 3) {
-            string line = "Walls = " + to_string(walls.size()) + "/200";
-            cout << line << string(margin - 1 - line.length(), ' ');
-        } else if (y == 4) {
-            string line = "Gold Mines = " + to_string(goldMines.size()) + "/3";
-            cout << line << string(margin - 1 - line.length(), ' ');
-        } else if (y == 5) {
-            string line = "Elixir Generators = " + to_string(elixirCollectors.size()) + "/3";
-            cout << line << string(margin - 1 - line.length(), ' ');
-        } else if (y == 6) {
-            string line = "Town Hall HP = " + to_string(townhall.getHealth());
-            cout << line << string(margin - 1 - line.length(), ' ');
-        } else if (y == 7) {
-            string line = "Enemies = " + to_string(enemies.size());
-            cout << line << string(margin - 1 - line.length(), ' ');
-        } else if (y == 8) {
-            string line = "Raiders = " + to_string(raiderCount);
-            cout << line << string(margin - 1 - line.length(), ' ');
-        } else if (y == 9) {
-            string line = "Bombermen = " + to_string(bombermanCount);
-            cout << line << string(margin - 1 - line.length(), ' ');
-        } else if (y == 11) {
-            string line = "Troops = " + to_string(troops.size());
-            cout << line << string(margin - 1 - line.length(), ' ');
-        } else if (y == 12) {
-            string line = "Archers = " + to_string(archerCount);
-            cout << line << string(margin - 1 - line.length(), ' ');
-        } else if (y == 13) {
-            string line = "Barbarians = " + to_string(barbarianCount);
-            cout << line << string(margin - 1 - line.length(), ' ');
-        } else {
-            cout << string(margin - 1, ' ');
+    {
+        PROFILE_SCOPE(Metric::TICK_NS);
+        {
+            PROFILE_SCOPE(Metric::SPAWN_NS);
+            spawnWaves();
+        }
+        {
+            PROFILE_SCOPE(Metric::ENEMIES_NS);
+            updateEnemies();
+        }
+        {
+            PROFILE_SCOPE(Metric::TROOPS_NS);
+            updateTroops();  // Update troops behavior
+        }
+        {
+            PROFILE_SCOPE(Metric::RESOURCES_NS);
+            updateResources();
         }
-
-        cout << "|";
-        cout << string(width - margin - 2, ' ') << "|" << endl;
     }
-}
\ No newline at end of file
+    rng.advance();
+    if (profilerTicks) PROFILE_END_TICK();
+}
@@ -1,85 +1,42 @@
 /**
  * @file Bomberman.cpp
- * @brief Implementation of the Bomberman enemy class
+ * @brief Targeting rules of the Bomberman enemy
  */
 
 #include "Bomberman.h"
-#include <cmath>
+#include "EnemySystem.h"
 
 /**
- * @brief Constructor for Bomberman enemy
- * 
- * Creates a Bomberman with:
- * - Icon: "💣" (bomb)
- * - Damage: 25 points per attack (higher than Raider)
- * - Speed: 20 (slower than Raider)
- * 
- * @param x Initial X-coordinate
- * @param y Initial Y-coordinate
- */
-Bomberman::Bomberman(int x, int y)
-    : Enemy(x, y, EnemyType::BOMBERMAN, "💣", 25, 20) {}
-
-/**
- * @brief Find target for Bomberman
+ * @brief Find target for a Bomberman
  * 
  * Bombermen prioritize walls over other buildings
  * 
- * @param walls Vector of walls
- * @param goldMines Vector of gold mines
- * @param elixirCollectors Vector of elixir collectors
- * @param townhall Town hall reference
- * @return Pointer to the target building, or nullptr if no building is in range
+ * @param myPos Position of the Bomberman
+ * @param buildings Buildings to choose from
+ * @return Handle of the target building, or none if no building is in range
  */
-Building* Bomberman::findTarget(vector<Wall>& walls, vector<GoldMine>& goldMines,
-                             vector<ElixirCollector>& elixirCollectors, const TownHall& townhall) {
+BuildingHandle UnitType<UnitKind::BOMBERMAN>::findTarget(const Position& myPos, const BuildingStore& buildings) {
     // Bombermen prioritize walls over other buildings
-    Building* closestWall = nullptr;
-    double minWallDist = 1000000;  // Large initial value
-    Position myPos = getPosition();
-    
-    // Check walls
-    for (auto& wall : walls) {
-        double dist = calculateDistance(myPos, wall.getPosition());
-        if (dist < minWallDist) {
-            minWallDist = dist;
-            closestWall = &wall;
-        }
-    }
+    BuildingHandle closestWall;
+    int minWallDist = ATTACK_REACH_SQUARED;
+    closerTarget(myPos, BuildingKind::WALL, buildings.walls, buildings.wallBoxes, closestWall, minWallDist);
     
     // If there's a wall nearby, target it
-    if (closestWall && minWallDist < 2) {
+    if (!closestWall.isNone()) {
         return closestWall;
     }
     
     // If no walls or walls are too far, check other buildings
-    Building* closestOther = nullptr;
-    double minOtherDist = 1000000;
-    
-    // Check gold mines
-    for (auto& mine : goldMines) {
-        double dist = calculateDistance(myPos, mine.getPosition());
-        if (dist < minOtherDist) {
-            minOtherDist = dist;
-            closestOther = &mine;
-        }
-    }
-    
-    // Check elixir collectors
-    for (auto& collector : elixirCollectors) {
-        double dist = calculateDistance(myPos, collector.getPosition());
-        if (dist < minOtherDist) {
-            minOtherDist = dist;
-            closestOther = &collector;
-        }
-    }
+    BuildingHandle closestOther;
+    int minOtherDist = ATTACK_REACH_SQUARED;
+    closerTarget(myPos, BuildingKind::GOLD_MINE, buildings.goldMines, buildings.goldMineBoxes, closestOther, minOtherDist);
+    closerTarget(myPos, BuildingKind::ELIXIR_COLLECTOR, buildings.elixirCollectors, buildings.elixirCollectorBoxes,
+                 closestOther, minOtherDist);
     
     // Check town hall
-    double dist_th = calculateDistance(myPos, townhall.getPosition());
-    if (dist_th < minOtherDist) {
-        minOtherDist = dist_th;
-        closestOther = const_cast<TownHall*>(&townhall);
+    if (squaredDistance(myPos, buildings.townhall.closestPointTo(myPos)) < minOtherDist) {
+        closestOther = buildings.townhallHandle();
     }
     
-    return (minOtherDist < 2) ? closestOther : nullptr;
+    return closestOther;
 }
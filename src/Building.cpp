@@ -4,6 +4,7 @@
  */
 
 #include "Building.h"
+#include <algorithm>
 using namespace std;
 
 /**
@@ -17,14 +18,14 @@ using namespace std;
  * @param costElixir Elixir cost to construct this building
  * @param health Initial and maximum health points of the building
  * @param maxInstances Maximum number of this building type allowed
- * @param icon Visual representation of the building (emoji or character)
+ * @param icon Visual representation of the building (emoji or character), as a glyph id
  * @param hasBorder Whether the building should be drawn with a border
  */
 Building::Building(int x, int y, int sizeX, int sizeY, int costGold, int costElixir, 
-         int health, int maxInstances, const string& icon, bool hasBorder)
+         int health, int maxInstances, Glyph icon, bool hasBorder)
     : pos(x, y), sizeX(sizeX), sizeY(sizeY), costGold(costGold), 
       costElixir(costElixir), health(health), maxInstances(maxInstances), 
-      icon(icon), hasBorder(hasBorder) {}
+      icon(icon), hasBorder(hasBorder), id(0) {}
 
 // Accessor methods
 
@@ -36,9 +37,9 @@ const Position& Building::getPosition() const { return pos; }
 
 /**
  * @brief Get the building's visual representation
- * @return Reference to the icon string
+ * @return Id of the icon in the GlyphTable
  */
-const string& Building::getIcon() const { return icon; }
+Glyph Building::getIcon() const { return icon; }
 
 /**
  * @brief Get the gold cost of the building
@@ -82,6 +83,34 @@ int Building::getSizeY() const { return sizeY; }
  */
 bool Building::Border() const { return hasBorder; }
 
+/**
+ * @brief Get the cell of the building's footprint closest to a position
+ *
+ * Used to measure distances to the whole footprint rather than to its
+ * top-left corner.
+ *
+ * @param from Reference position
+ * @return Closest cell inside the footprint
+ */
+Position Building::closestPointTo(const Position& from) const {
+    int x = min(max(from.x, pos.x), pos.x + sizeX - 1);
+    int y = min(max(from.y, pos.y), pos.y + sizeY - 1);
+    return Position(x, y);
+}
+
+/**
+ * @brief Get the building's board-wide identifier
+ * @return Identifier assigned on placement, 0 if not placed
+ */
+uint32_t Building::getId() const { return id; }
+
+/**
+ * @brief Set the building's board-wide identifier
+ *
+ * @param newId Identifier used by the occupancy grid
+ */
+void Building::setId(uint32_t newId) { id = newId; }
+
 /**
  * @brief Set a new position for the building
  * 
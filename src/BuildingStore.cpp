@@ -0,0 +1,86 @@
+/**
+ * @file BuildingStore.cpp
+ * @brief Handle resolution and damage bookkeeping for all buildings
+ */
+
+#include "BuildingStore.h"
+
+BuildingStore::BuildingStore(const TownHall& townhall) : townhall(townhall) {}
+
+namespace {
+// Inserts into a slot map and appends the footprint at the same dense index
+template<typename T>
+SlotHandle addTo(SlotMap<T>& map, BoxArray& boxes, const T& building) {
+    boxes.push(building);
+    return map.insert(building);
+}
+
+// Swap-removes from a slot map and mirrors the move in the footprints
+template<typename T>
+bool removeFrom(SlotMap<T>& map, BoxArray& boxes, SlotHandle handle) {
+    long index = map.indexOf(handle);
+    if (index < 0) return false;
+    boxes.swapRemove(static_cast<size_t>(index));
+    return map.erase(handle);
+}
+}
+
+/**
+ * @brief Store a building and its footprint
+ *
+ * @return Handle of the stored building
+ */
+BuildingHandle BuildingStore::add(const Wall& wall) {
+    return BuildingHandle{BuildingKind::WALL, addTo(walls, wallBoxes, wall)};
+}
+
+BuildingHandle BuildingStore::add(const GoldMine& mine) {
+    return BuildingHandle{BuildingKind::GOLD_MINE, addTo(goldMines, goldMineBoxes, mine)};
+}
+
+BuildingHandle BuildingStore::add(const ElixirCollector& collector) {
+    return BuildingHandle{BuildingKind::ELIXIR_COLLECTOR, addTo(elixirCollectors, elixirCollectorBoxes, collector)};
+}
+
+/**
+ * @brief Building a handle refers to, or nullptr if it is gone
+ */
+Building* BuildingStore::get(BuildingHandle handle) {
+    switch (handle.kind) {
+        case BuildingKind::TOWNHALL: return &townhall;
+        case BuildingKind::WALL: return walls.get(handle.slot);
+        case BuildingKind::GOLD_MINE: return goldMines.get(handle.slot);
+        case BuildingKind::ELIXIR_COLLECTOR: return elixirCollectors.get(handle.slot);
+        default: return nullptr;
+    }
+}
+
+const Building* BuildingStore::get(BuildingHandle handle) const {
+    return const_cast<BuildingStore*>(this)->get(handle);
+}
+
+/**
+ * @brief Damage a building and queue it in destroyed when its health reaches zero
+ */
+void BuildingStore::damage(BuildingHandle handle, int amount) {
+    Building* building = get(handle);
+    if (!building) return;
+
+    bool wasStanding = building->getHealth() > 0;
+    building->takeDamage(amount);
+    if (wasStanding && building->getHealth() <= 0) destroyed.push_back(handle);
+}
+
+/**
+ * @brief Remove a destroyed building (the Town Hall is never removed)
+ *
+ * @return false if the handle was stale or the Town Hall
+ */
+bool BuildingStore::remove(BuildingHandle handle) {
+    switch (handle.kind) {
+        case BuildingKind::WALL: return removeFrom(walls, wallBoxes, handle.slot);
+        case BuildingKind::GOLD_MINE: return removeFrom(goldMines, goldMineBoxes, handle.slot);
+        case BuildingKind::ELIXIR_COLLECTOR: return removeFrom(elixirCollectors, elixirCollectorBoxes, handle.slot);
+        default: return false;
+    }
+}
@@ -0,0 +1,190 @@
+/**
+ * @file Distance.cpp
+ * @brief Integer distance kernels with run-time SIMD dispatch
+ */
+
+#include "Distance.h"
+#include <climits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define DISTANCE_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define DISTANCE_X86_KERNELS 0
+#endif
+
+/**
+ * @brief Append the footprint of a building
+ */
+void BoxArray::push(const Building& building) {
+    const Position& pos = building.getPosition();
+    minX.push_back(pos.x);
+    minY.push_back(pos.y);
+    maxX.push_back(pos.x + building.getSizeX() - 1);
+    maxY.push_back(pos.y + building.getSizeY() - 1);
+}
+
+/**
+ * @brief Move the last box into slot i and drop the last (mirrors SlotMap::erase)
+ */
+void BoxArray::swapRemove(size_t i) {
+    minX[i] = minX.back();
+    minY[i] = minY.back();
+    maxX[i] = maxX.back();
+    maxY[i] = maxY.back();
+    minX.pop_back();
+    minY.pop_back();
+    maxX.pop_back();
+    maxY.pop_back();
+}
+
+namespace {
+
+// Finds the closest box over [begin, size()), starting from a best-so-far
+void nearestScalar(const BoxArray& boxes, size_t begin, int px, int py, int& best, int& bestDist) {
+    for (size_t i = begin; i < boxes.size(); ++i) {
+        int d = squaredDistanceToBox(px, py, boxes.minX[i], boxes.minY[i], boxes.maxX[i], boxes.maxY[i]);
+        if (d < bestDist) {
+            bestDist = d;
+            best = static_cast<int>(i);
+        }
+    }
+}
+
+int nearestPortable(const BoxArray& boxes, int px, int py, int& bestDist) {
+    int best = -1;
+    bestDist = INT_MAX;
+    nearestScalar(boxes, 0, px, py, best, bestDist);
+    return best;
+}
+
+#if DISTANCE_X86_KERNELS
+
+// Reduce per-lane winners: smallest distance, then lowest index
+int reduceLanes(const int* dist, const int* index, int lanes, int& bestDist) {
+    int best = -1;
+    bestDist = INT_MAX;
+    for (int l = 0; l < lanes; ++l) {
+        if (index[l] < 0) continue;
+        if (dist[l] < bestDist || (dist[l] == bestDist && index[l] < best)) {
+            bestDist = dist[l];
+            best = index[l];
+        }
+    }
+    return best;
+}
+
+__attribute__((target("avx2")))
+int nearestAvx2(const BoxArray& boxes, int px, int py, int& bestDist) {
+    const size_t n = boxes.size();
+    const __m256i x = _mm256_set1_epi32(px);
+    const __m256i y = _mm256_set1_epi32(py);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i step = _mm256_set1_epi32(8);
+    __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i laneDist = _mm256_set1_epi32(INT_MAX);
+    __m256i laneIndex = _mm256_set1_epi32(-1);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&boxes.minX[i]));
+        __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&boxes.maxX[i]));
+        __m256i y0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&boxes.minY[i]));
+        __m256i y1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&boxes.maxY[i]));
+        __m256i dx = _mm256_max_epi32(_mm256_max_epi32(_mm256_sub_epi32(x0, x), _mm256_sub_epi32(x, x1)), zero);
+        __m256i dy = _mm256_max_epi32(_mm256_max_epi32(_mm256_sub_epi32(y0, y), _mm256_sub_epi32(y, y1)), zero);
+        __m256i d = _mm256_add_epi32(_mm256_mullo_epi32(dx, dx), _mm256_mullo_epi32(dy, dy));
+
+        // Strictly closer only, so each lane keeps its lowest index on ties
+        __m256i closer = _mm256_cmpgt_epi32(laneDist, d);
+        laneDist = _mm256_blendv_epi8(laneDist, d, closer);
+        laneIndex = _mm256_blendv_epi8(laneIndex, lane, closer);
+        lane = _mm256_add_epi32(lane, step);
+    }
+
+    alignas(32) int dist[8];
+    alignas(32) int index[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(dist), laneDist);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(index), laneIndex);
+    int best = reduceLanes(dist, index, 8, bestDist);
+    nearestScalar(boxes, i, px, py, best, bestDist);
+    return best;
+}
+
+__attribute__((target("sse4.1")))
+int nearestSse41(const BoxArray& boxes, int px, int py, int& bestDist) {
+    const size_t n = boxes.size();
+    const __m128i x = _mm_set1_epi32(px);
+    const __m128i y = _mm_set1_epi32(py);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i step = _mm_set1_epi32(4);
+    __m128i lane = _mm_setr_epi32(0, 1, 2, 3);
+    __m128i laneDist = _mm_set1_epi32(INT_MAX);
+    __m128i laneIndex = _mm_set1_epi32(-1);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&boxes.minX[i]));
+        __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&boxes.maxX[i]));
+        __m128i y0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&boxes.minY[i]));
+        __m128i y1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&boxes.maxY[i]));
+        __m128i dx = _mm_max_epi32(_mm_max_epi32(_mm_sub_epi32(x0, x), _mm_sub_epi32(x, x1)), zero);
+        __m128i dy = _mm_max_epi32(_mm_max_epi32(_mm_sub_epi32(y0, y), _mm_sub_epi32(y, y1)), zero);
+        __m128i d = _mm_add_epi32(_mm_mullo_epi32(dx, dx), _mm_mullo_epi32(dy, dy));
+
+        __m128i closer = _mm_cmpgt_epi32(laneDist, d);
+        laneDist = _mm_blendv_epi8(laneDist, d, closer);
+        laneIndex = _mm_blendv_epi8(laneIndex, lane, closer);
+        lane = _mm_add_epi32(lane, step);
+    }
+
+    alignas(16) int dist[4];
+    alignas(16) int index[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(dist), laneDist);
+    _mm_store_si128(reinterpret_cast<__m128i*>(index), laneIndex);
+    int best = reduceLanes(dist, index, 4, bestDist);
+    nearestScalar(boxes, i, px, py, best, bestDist);
+    return best;
+}
+
+#endif
+
+using Kernel = int (*)(const BoxArray&, int, int, int&);
+
+struct Dispatch {
+    Kernel kernel;
+    const char* name;
+};
+
+Dispatch selectKernel() {
+#if DISTANCE_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return Dispatch{nearestAvx2, "avx2"};
+    if (__builtin_cpu_supports("sse4.1")) return Dispatch{nearestSse41, "sse4.1"};
+#endif
+    return Dispatch{nearestPortable, "scalar"};
+}
+
+const Dispatch& dispatch() {
+    static const Dispatch selected = selectKernel();
+    return selected;
+}
+
+}
+
+/**
+ * @brief Closest box to a cell within a squared radius
+ */
+int nearestBoxWithin(const BoxArray& boxes, int px, int py, int maxDistanceSquared, int* distanceSquared) {
+    if (boxes.size() == 0) return -1;
+
+    int bestDist;
+    int best = dispatch().kernel(boxes, px, py, bestDist);
+    if (best < 0 || bestDist > maxDistanceSquared) return -1;
+    if (distanceSquared) *distanceSquared = bestDist;
+    return best;
+}
+
+const char* distanceKernelName() {
+    return dispatch().name;
+}
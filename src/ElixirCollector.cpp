@@ -19,7 +19,7 @@
  * @param x X-coordinate for collector placement
  * @param y Y-coordinate for collector placement
  */
-ElixirCollector::ElixirCollector(int x, int y) : ResourceGenerator(x, y, 7, 3, 100, 0, 100, 3, "💧", 100) {}
+ElixirCollector::ElixirCollector(int x, int y) : ResourceGenerator(x, y, 7, 3, 100, 0, 100, 3, Glyph::WATER_DROP, 100) {}
 
 /**
  * @brief Assignment operator for ElixirCollector
@@ -41,39 +41,24 @@ ElixirCollector& ElixirCollector::operator=(const ElixirCollector& other) {
         maxInstances = other.maxInstances;
         icon = other.icon;
         hasBorder = other.hasBorder;
+        id = other.id;
         
         // Copy ResourceGenerator properties
-        currentAmount = other.currentAmount;
+        fillStart = other.fillStart;
     }
     return *this;
 }
 
 /**
- * @brief Updates the elixir collector's resource accumulation
- * 
- * Generates 5 elixir per update until reaching capacity
- * Changes icon to "🧪" (test tube) when full
+ * @brief Shows the "🧪" (test tube) icon once the collector is full
  */
-void ElixirCollector::update() {
-    if (currentAmount < capacity) {
-        currentAmount += 5;
-        if (currentAmount >= capacity) {
-            icon = "🧪";  // Change to test tube icon when full
-        }
-    }
+void ElixirCollector::showFull() {
+    icon = Glyph::TEST_TUBE;
 }
 
 /**
- * @brief Collects accumulated elixir from the collector
- * 
- * @return The amount of elixir collected if collector is full, 0 otherwise
+ * @brief Shows the "‼️ " (empty) icon after the collector is collected
  */
-int ElixirCollector::collect() {
-    if (currentAmount >= capacity) {
-        int collected = currentAmount;
-        currentAmount = 0;
-        icon = "‼️ ";  // Reset to empty icon after collection
-        return collected;
-    }
-    return 0;  // Nothing to collect yet
+void ElixirCollector::showEmpty() {
+    icon = Glyph::DOUBLE_BANG;
 }
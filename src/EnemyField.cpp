@@ -0,0 +1,167 @@
+/**
+ * @file EnemyField.cpp
+ * @brief Implementation of the per-tick distance field toward enemies
+ */
+
+#include "EnemyField.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+// 4-way neighbourhood, matching the Manhattan ranges troops attack at
+const int NEIGHBOUR_DX[4] = { 0, 0, -1, 1 };
+const int NEIGHBOUR_DY[4] = { -1, 1, 0, 0 };
+// Step to each neighbour within a chunk's row-major cells
+const int CHUNK_NEIGHBOUR_OFFSET[4] = { -CHUNK_SIZE, CHUNK_SIZE, -1, 1 };
+}
+
+EnemyField::EnemyField(int width, int height, int minX, int minY, int maxX, int maxY)
+    : width(width), height(height),
+      minX(minX), minY(minY), maxX(maxX), maxY(maxY),
+      dist(width, height, UNREACHABLE) {}
+
+/**
+ * @brief Writable distance of a cell, allocating its chunk on first use
+ *
+ * Cells of a new chunk outside the play area are set to OUTSIDE.
+ */
+uint32_t& EnemyField::touch(int x, int y) {
+    return dist.cell(x, y, [this](int left, int top) {
+        for (int cy = top; cy < std::min(top + CHUNK_SIZE, height); ++cy) {
+            for (int cx = left; cx < std::min(left + CHUNK_SIZE, width); ++cx) {
+                if (!inPlayArea(cx, cy)) dist.cell(cx, cy) = OUTSIDE;
+            }
+        }
+    });
+}
+
+/**
+ * @brief Search from the enemies until every reader has a distance
+ *
+ * Plain breadth-first search: every step costs 1, so cells are reached in
+ * distance order and a cell's distance is final when it is reached. Cells
+ * outside the play area hold OUTSIDE, which the search never reaches, and
+ * the play area never touches the grid edge, so neighbours of reached
+ * cells are on the grid; away from the chunk border they are a fixed step
+ * away in memory. Occupancy is only read for the cells reached.
+ */
+void EnemyField::build(const std::vector<Position>& enemies, const std::vector<Position>& readers,
+                       const OccupancyGrid& grid) {
+    for (const Reached& entry : queue) *entry.cell = UNREACHABLE;
+    for (uint32_t* cell : readerCells) *cell = UNREACHABLE;
+    queue.clear();
+    readerCells.clear();
+    obstacles = &grid;
+
+    size_t pending = 0;
+    for (const Position& pos : readers) {
+        if (!inPlayArea(pos.x, pos.y)) continue;
+        uint32_t& d = touch(pos.x, pos.y);
+        if (d == READER) continue;
+        d = READER;
+        readerCells.push_back(&d);
+        ++pending;
+    }
+    if (enemies.empty() || pending == 0) return;
+    const size_t budget = std::max(MIN_SEARCH_CELLS, SEARCH_CELLS_PER_READER * pending);
+
+    // Marks a cell reached at distance d; covered cells get OBSTACLE
+    auto reach = [&](uint32_t& cell, uint32_t d, int x, int y) {
+        if (cell == READER) --pending;
+        cell = grid.at(x, y).id != 0 ? d | OBSTACLE : d;
+        queue.push_back(Reached{pack(x, y), &cell});
+    };
+    for (const Position& pos : enemies) {
+        if (!inPlayArea(pos.x, pos.y)) continue;
+        uint32_t& cell = touch(pos.x, pos.y);
+        if (cell >= READER) reach(cell, 0, pos.x, pos.y);
+    }
+
+    // Sources row by row keep each ring of the search close to the last
+    std::sort(queue.begin(), queue.end(), [](const Reached& a, const Reached& b) { return a.key < b.key; });
+
+    for (size_t head = 0; head < queue.size() && pending > 0 && queue.size() < budget; ++head) {
+        int x = unpackX(queue[head].key);
+        int y = unpackY(queue[head].key);
+        uint32_t* here = queue[head].cell;
+        uint32_t d = *here & ~OBSTACLE;
+
+        // Enemies inside a building are still sources; other covered cells are dead ends
+        if (d != 0 && (*here & OBSTACLE)) continue;
+
+        int cx = x & (CHUNK_SIZE - 1);
+        int cy = y & (CHUNK_SIZE - 1);
+        if (cx > 0 && cx < CHUNK_SIZE - 1 && cy > 0 && cy < CHUNK_SIZE - 1) {
+            for (int k = 0; k < 4; ++k) {
+                uint32_t& n = here[CHUNK_NEIGHBOUR_OFFSET[k]];
+                if (n >= READER) reach(n, d + 1, x + NEIGHBOUR_DX[k], y + NEIGHBOUR_DY[k]);
+            }
+        } else {
+            for (int k = 0; k < 4; ++k) {
+                uint32_t& n = touch(x + NEIGHBOUR_DX[k], y + NEIGHBOUR_DY[k]);
+                if (n >= READER) reach(n, d + 1, x + NEIGHBOUR_DX[k], y + NEIGHBOUR_DY[k]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Check whether the last build gave a cell its distance
+ */
+bool EnemyField::reached(const Position& pos) const {
+    return inPlayArea(pos.x, pos.y) && dist.at(pos.x, pos.y) < OUTSIDE;
+}
+
+/**
+ * @brief Steps from a cell to the nearest enemy
+ */
+uint32_t EnemyField::distanceAt(int x, int y) const {
+    if (!inPlayArea(x, y)) return UNREACHABLE;
+    uint32_t d = dist.at(x, y);
+    return d >= OUTSIDE ? UNREACHABLE : d & ~OBSTACLE;
+}
+
+/**
+ * @brief Best next cell from a position
+ *
+ * Covered, outside and unreached cells carry OBSTACLE, which makes their
+ * distance larger than any a reached cell can have, so they are never
+ * chosen.
+ */
+Position EnemyField::nextStep(const Position& from) const {
+    if (!inPlayArea(from.x, from.y)) return from;
+    Position best = from;
+    uint32_t bestDist = dist.at(from.x, from.y) & ~OBSTACLE;
+
+    for (int k = 0; k < 4; ++k) {
+        int nx = from.x + NEIGHBOUR_DX[k];
+        int ny = from.y + NEIGHBOUR_DY[k];
+        uint32_t nd = dist.at(nx, ny);
+        if (nd < bestDist) {
+            bestDist = nd;
+            best = Position(nx, ny);
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief One straight step toward a target, for readers the search did not reach
+ *
+ * Moves along the axis with the greater distance.
+ */
+Position EnemyField::straightStep(const Position& from, const Position& target) const {
+    int dx = target.x - from.x;
+    int dy = target.y - from.y;
+    int stepX = dx == 0 ? 0 : (dx > 0 ? 1 : -1);
+    int stepY = dy == 0 ? 0 : (dy > 0 ? 1 : -1);
+
+    Position next = from;
+    if (std::abs(dx) > std::abs(dy)) {
+        next = stepX != 0 ? Position(from.x + stepX, from.y) : Position(from.x, from.y + stepY);
+    } else {
+        next = stepY != 0 ? Position(from.x, from.y + stepY) : Position(from.x + stepX, from.y);
+    }
+    if (!inPlayArea(next.x, next.y) || (obstacles && obstacles->at(next.x, next.y).id != 0)) return from;
+    return next;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file EnemySystem.cpp
+ * @brief Per-tick behavior of enemy archetypes
+ */
+
+#include "EnemySystem.h"
+#include "UnitTypes.h"
+#include "Profiler.h"
+
+namespace {
+// Enemies per parallel work item
+const size_t ENEMY_CHUNK = 256;
+
+/**
+ * @brief Enemy update of one kind; stats and targeting are resolved at compile time
+ */
+template<UnitKind K>
+bool updateEnemies(UnitArchetype& enemies, const FlowField& field, const Rng& rng,
+                   BuildingStore& buildings, ThreadPool& pool, vector<vector<BuildingHit>>& hits) {
+    using Type = UnitType<K>;
+    constexpr UnitStats stats = Type::stats;
+    const size_t count = enemies.size();
+    Position* position = enemies.position.data();
+    int* damage = enemies.damage.data();
+    int* speedCounter = enemies.speedCounter.data();
+    BuildingHandle* target = enemies.target.data();
+    const BuildingStore& view = buildings;
+
+    hits.resize(pool.size());
+    for (auto& buffer : hits) buffer.clear();
+
+    // Decide phase: buildings are only read. Each enemy writes its own
+    // components and queues its damage in its worker's buffer.
+    pool.parallelFor(count, ENEMY_CHUNK, [&](size_t begin, size_t end, int worker) {
+        vector<BuildingHit>& out = hits[worker];
+        for (size_t i = begin; i < end; ++i) {
+            // Enemies already attacking a building keep hitting it; attacking takes the whole tick
+            if (!target[i].isNone()) {
+                out.push_back(BuildingHit{target[i], damage[i]});
+                continue;
+            }
+
+            // Speed control
+            if (++speedCounter[i] < stats.speed) continue;
+            speedCounter[i] = 0;
+
+            // Try to find any nearby target to attack, by the kind's rule
+            Position myPos = position[i];
+            PROFILE_COUNT(Metric::FIND_TARGET_CALLS, 1);
+            BuildingHandle found = Type::findTarget(myPos, view);
+            
+            // If adjacent to a building, attack it
+            if (!found.isNone()) {
+                target[i] = found;
+                out.push_back(BuildingHit{found, damage[i]});
+                continue;
+            }
+            
+            Position newPos = field.nextStep(myPos);
+            
+            // Add randomness to movement (different behaviors based on enemy type).
+            // A deviation is only taken if it does not lead away from the Town Hall.
+            // Each enemy draws from its own stream, so the result does not depend
+            // on update order.
+            RngStream random = rng.stream(enemies.id[i]);
+            if (random.uniform(1, 10) <= stats.deviationChance) {
+                int dx = random.uniform(-1, 1);
+                int dy = random.uniform(-1, 1);
+                Position altPos(myPos.x + dx, myPos.y + dy);
+                uint32_t here = field.distanceAt(myPos.x, myPos.y);
+                if (!(altPos == myPos) && field.isPassable(altPos.x, altPos.y) &&
+                    field.distanceAt(altPos.x, altPos.y) <= here) {
+                    newPos = altPos;
+                }
+            }
+            
+            // The field never leads through blocked cells, so Raiders route around
+            // walls while Bombermen walk up to them and blow them up
+            position[i] = newPos;
+        }
+    });
+
+    // Apply phase: each worker's queued hits, subtracted from building health
+    for (const auto& buffer : hits) {
+        for (const BuildingHit& hit : buffer) buildings.damage(hit.building, hit.damage);
+    }
+
+    // Stop attacking buildings that are destroyed or already removed
+    for (size_t i = 0; i < count; ++i) {
+        if (target[i].isNone()) continue;
+        const Building* building = view.get(target[i]);
+        if (!building || building->getHealth() <= 0) target[i] = BuildingHandle{};
+    }
+    return buildings.townhall.getHealth() <= 0;
+}
+
+}
+
+/**
+ * @brief Updates every enemy of one archetype for a tick
+ * 
+ * @return true if town hall is destroyed (game over), false otherwise
+ */
+bool updateEnemyArchetype(UnitArchetype& enemies, const FlowField& field, const Rng& rng,
+                          BuildingStore& buildings, ThreadPool& pool, vector<vector<BuildingHit>>& hits) {
+    bool townhallDestroyed = false;
+    forEachKind(EnemyKinds(), [&](auto kind) {
+        if (enemies.kind == kind) townhallDestroyed = updateEnemies<decltype(kind)::value>(enemies, field, rng, buildings, pool, hits);
+    });
+    return townhallDestroyed;
+}
@@ -0,0 +1,433 @@
+/**
+ * @file FlowField.cpp
+ * @brief Implementation of the incrementally searched and repaired distance field
+ */
+
+#include "FlowField.h"
+#include <algorithm>
+#include <functional>
+
+namespace {
+// 8-way neighbourhood; straight moves first so ties prefer them
+const int NEIGHBOUR_DX[8] = { 0, 0, -1, 1, -1, 1, -1, 1 };
+const int NEIGHBOUR_DY[8] = { -1, 1, 0, 0, -1, -1, 1, 1 };
+// Step to each neighbour within a chunk's row-major cells
+const int CHUNK_NEIGHBOUR_OFFSET[8] = {
+    -CHUNK_SIZE, CHUNK_SIZE, -1, 1, -CHUNK_SIZE - 1, -CHUNK_SIZE + 1, CHUNK_SIZE - 1, CHUNK_SIZE + 1
+};
+}
+
+FlowField::FlowField(int width, int height, int minX, int minY, int maxX, int maxY,
+                     FlowFieldMode mode, uint16_t wallCost)
+    : width(width), height(height),
+      minX(minX), minY(minY), maxX(maxX), maxY(maxY),
+      mode(mode), wallCost(wallCost),
+      maxCost(mode == FlowFieldMode::WALL_COST ? std::max<uint32_t>(wallCost, 1) : 1),
+      cells(width, height, Cell{UNREACHABLE, BLOCKED, 0, 0}),
+      buckets(maxCost + 1) {}
+
+/**
+ * @brief Cost of entering a cell given the current walls
+ *
+ * Cells within one step of a wall are blocked or penalised depending on mode.
+ */
+uint16_t FlowField::cellCost(const OccupancyGrid& grid, int x, int y) const {
+    if (!inPlayArea(x, y)) return BLOCKED;
+
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if (grid.hasKind(x + dx, y + dy, BuildingKind::WALL)) {
+                return mode == FlowFieldMode::AVOID_WALLS ? BLOCKED : wallCost;
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Writable cell, allocating and costing its chunk on first use
+ */
+FlowField::Cell& FlowField::touch(int x, int y) {
+    return cells.cell(x, y, [this](int left, int top) { costChunk(left, top); });
+}
+
+/**
+ * @brief Set the costs of a new chunk from the current walls
+ *
+ * Same costs as cellCost() for every cell: open play area first, then
+ * the neighbourhood of each wall in or next to the chunk.
+ */
+void FlowField::costChunk(int left, int top) {
+    Cell* chunk = &cells.cell(left, top);
+    int right = std::min(left + CHUNK_SIZE, width) - 1;
+    int bottom = std::min(top + CHUNK_SIZE, height) - 1;
+    for (int y = std::max(top, minY); y <= std::min(bottom, maxY); ++y) {
+        for (int x = std::max(left, minX); x <= std::min(right, maxX); ++x) {
+            chunk[(y - top) * CHUNK_SIZE + (x - left)].cost = 1;
+        }
+    }
+
+    uint16_t nearWall = mode == FlowFieldMode::AVOID_WALLS ? BLOCKED : wallCost;
+    walls->forEachOccupiedIn(left - 1, top - 1, right + 1, bottom + 1, [&](int wx, int wy, const Occupant& cell) {
+        if (cell.kind != BuildingKind::WALL) return;
+        for (int y = std::max(wy - 1, top); y <= std::min(wy + 1, bottom); ++y) {
+            for (int x = std::max(wx - 1, left); x <= std::min(wx + 1, right); ++x) {
+                if (inPlayArea(x, y)) chunk[(y - top) * CHUNK_SIZE + (x - left)].cost = nearWall;
+            }
+        }
+    });
+}
+
+/**
+ * @brief Give a cell a lower distance and queue it where it belongs
+ *
+ * Distances below the search level go on the repair heap; the others wait
+ * in the bucket ring for the search to reach them.
+ */
+void FlowField::lower(Cell& cell, uint32_t key, uint32_t d) {
+    cell.dist = d;
+    if (d < level) {
+        dequeue(cell);
+        frontierScratch.emplace_back(d, key);
+        std::push_heap(frontierScratch.begin(), frontierScratch.end(), std::greater<HeapEntry>());
+        return;
+    }
+    if (!(cell.flags & QUEUED)) {
+        cell.flags |= QUEUED;
+        ++pending;
+    }
+    buckets[d % buckets.size()].push_back(key);
+}
+
+/**
+ * @brief Drop a cell from the search; its bucket entry goes stale
+ */
+void FlowField::dequeue(Cell& cell) {
+    if (!(cell.flags & QUEUED)) return;
+    cell.flags &= ~QUEUED;
+    --pending;
+}
+
+/* Cells outside the play area are BLOCKED and goal cells are at distance
+ * 0, so neither needs a separate test. Every expanded cell lies in the
+ * play area, which never touches the grid edge, so its neighbours are on
+ * the grid; away from the chunk border they are a fixed step away in
+ * memory.
+ */
+void FlowField::relaxNeighbours(int x, int y, Cell& cell, uint32_t d) {
+    auto relax = [&](Cell& n, int k) {
+        if (n.cost == BLOCKED) return;
+        uint32_t nd = d + n.cost;
+        if (nd < n.dist) lower(n, pack(x + NEIGHBOUR_DX[k], y + NEIGHBOUR_DY[k]), nd);
+    };
+    int cx = x & (CHUNK_SIZE - 1);
+    int cy = y & (CHUNK_SIZE - 1);
+    if (cx > 0 && cx < CHUNK_SIZE - 1 && cy > 0 && cy < CHUNK_SIZE - 1) {
+        for (int k = 0; k < 8; ++k) relax((&cell)[CHUNK_NEIGHBOUR_OFFSET[k]], k);
+    } else {
+        for (int k = 0; k < 8; ++k) relax(touch(x + NEIGHBOUR_DX[k], y + NEIGHBOUR_DY[k]), k);
+    }
+}
+
+/**
+ * @brief Expand every cell waiting at the search level, then move the level on
+ *
+ * No step costs more than maxCost, so relaxing from the level only pushes
+ * to other buckets, and bucket d % (maxCost + 1) holds only cells at
+ * distance d (Dial's algorithm).
+ */
+void FlowField::expandLevel() {
+    std::vector<uint32_t>& bucket = buckets[level % buckets.size()];
+    for (uint32_t key : bucket) {
+        int x = unpackX(key);
+        int y = unpackY(key);
+        Cell& c = cells.cell(x, y);
+        if (c.dist != level || !(c.flags & QUEUED)) continue;  // Stale entry
+        dequeue(c);
+        relaxNeighbours(x, y, c, level);
+    }
+    bucket.clear();
+    ++level;
+}
+
+/**
+ * @brief Dijkstra relaxation of the repair heap
+ *
+ * Improvements that reach the search level are left in the buckets.
+ */
+void FlowField::propagate() {
+    std::vector<HeapEntry>& frontier = frontierScratch;
+    while (!frontier.empty()) {
+        std::pop_heap(frontier.begin(), frontier.end(), std::greater<HeapEntry>());
+        HeapEntry top = frontier.back();
+        frontier.pop_back();
+
+        int x = unpackX(top.second);
+        int y = unpackY(top.second);
+        Cell& c = cells.cell(x, y);
+        if (top.first != c.dist) continue;  // Stale entry
+        relaxNeighbours(x, y, c, top.first);
+    }
+}
+
+/**
+ * @brief Release every chunk and empty the search
+ */
+void FlowField::reset(const OccupancyGrid& grid, uint32_t searchLevel) {
+    walls = &grid;
+    cells.clear();
+    for (auto& bucket : buckets) bucket.clear();
+    level = searchLevel;
+    pending = 0;
+}
+
+/**
+ * @brief Start the field over from the target
+ */
+void FlowField::build(const OccupancyGrid& grid, const Building& target) {
+    reset(grid, 0);
+    forEachGoalCell(target, [&](int x, int y) {
+        Cell& c = touch(x, y);
+        c.goal = 1;
+        lower(c, pack(x, y), 0);
+    });
+}
+
+/**
+ * @brief Expand the search until a cell's distance is final
+ *
+ * A blocked cell never gets a distance unless it is a goal cell.
+ */
+void FlowField::settleCell(int x, int y) {
+    const Cell& c = touch(x, y);
+    if (c.cost == BLOCKED && !c.goal) return;
+    while (pending > 0 && c.dist >= level) expandLevel();
+}
+
+/**
+ * @brief Resume the search until the given cells can step along the field
+ *
+ * Once a cell is final, every neighbour closer to the target is too, and
+ * the others are no closer whatever the search finds later. A cell that
+ * cannot be entered has no distance of its own, so any reachable
+ * neighbour may be its next step and all of them are settled.
+ */
+void FlowField::settle(const std::vector<Position>& positions) {
+    for (const Position& pos : positions) {
+        if (inPlayArea(pos.x, pos.y)) {
+            const Cell& c = touch(pos.x, pos.y);
+            if (c.cost != BLOCKED || c.goal) {
+                settleCell(pos.x, pos.y);
+                continue;
+            }
+        }
+        for (int k = 0; k < 8; ++k) {
+            int nx = pos.x + NEIGHBOUR_DX[k];
+            int ny = pos.y + NEIGHBOUR_DY[k];
+            if (inPlayArea(nx, ny)) settleCell(nx, ny);
+        }
+    }
+}
+
+/**
+ * @brief Distances of the allocated chunks, for snapshots
+ *
+ * Cells of the last chunk column or row that fall off the grid are saved
+ * as UNREACHABLE.
+ */
+void FlowField::saveChunks(std::vector<uint32_t>& chunkIds, std::vector<uint32_t>& distances) const {
+    chunkIds.clear();
+    distances.clear();
+    size_t chunkCount = static_cast<size_t>(cells.getChunksX()) * cells.getChunksY();
+    for (size_t id = 0; id < chunkCount; ++id) {
+        if (!cells.hasChunkAt(id)) continue;
+        chunkIds.push_back(static_cast<uint32_t>(id));
+        int left = static_cast<int>(id % cells.getChunksX()) << CHUNK_SHIFT;
+        int top = static_cast<int>(id / cells.getChunksX()) << CHUNK_SHIFT;
+        for (int y = top; y < top + CHUNK_SIZE; ++y) {
+            for (int x = left; x < left + CHUNK_SIZE; ++x) {
+                distances.push_back(x < width && y < height ? cells.at(x, y).dist : UNREACHABLE);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Load chunks saved from a field with the same walls and target
+ *
+ * Every distance is checked against what a search of those walls can
+ * leave behind: goal cells at 0, no distance on a blocked cell, and
+ * waiting distances less than one step past the search level. Chunks the
+ * saved field had not entered are entered again by the search as before.
+ */
+bool FlowField::restore(const OccupancyGrid& grid, const Building& target, uint32_t searchLevel,
+                        const std::vector<uint32_t>& chunkIds, const std::vector<uint32_t>& distances) {
+    if (distances.size() != chunkIds.size() * CHUNK_CELLS) return false;
+    if (searchLevel >= UNREACHABLE - maxCost) return false;
+
+    reset(grid, searchLevel);
+    forEachGoalCell(target, [&](int x, int y) { touch(x, y).goal = 1; });
+
+    size_t chunkCount = static_cast<size_t>(cells.getChunksX()) * cells.getChunksY();
+    const uint32_t* saved = distances.data();
+    for (size_t i = 0; i < chunkIds.size(); ++i) {
+        uint32_t id = chunkIds[i];
+        if (id >= chunkCount || (i > 0 && id <= chunkIds[i - 1])) return false;
+
+        int left = static_cast<int>(id % cells.getChunksX()) << CHUNK_SHIFT;
+        int top = static_cast<int>(id / cells.getChunksX()) << CHUNK_SHIFT;
+        touch(left, top);
+        for (int y = top; y < top + CHUNK_SIZE; ++y) {
+            for (int x = left; x < left + CHUNK_SIZE; ++x) {
+                uint32_t d = *saved++;
+                if (d == UNREACHABLE) continue;
+                if (x >= width || y >= height) return false;
+
+                Cell& c = cells.cell(x, y);
+                if (c.goal ? d != 0 : (c.cost == BLOCKED || d == 0)) return false;
+                if (d >= level && d - level >= maxCost) return false;
+                if (d >= level) {
+                    lower(c, pack(x, y), d);
+                } else {
+                    c.dist = d;
+                }
+            }
+        }
+    }
+
+    bool goalKept = true;
+    forEachGoalCell(target, [&](int x, int y) { goalKept = goalKept && cells.at(x, y).dist == 0; });
+    return goalKept;
+}
+
+/**
+ * @brief Repair the field after walls changed inside a rectangle
+ *
+ * Chunks the search has not entered yet take their costs from the walls
+ * when it does, so only entered cells are refreshed. Re-seeding only reads
+ * final neighbours (below the search level): a waiting neighbour relaxes
+ * the cell itself when the search expands it.
+ */
+void FlowField::repair(const OccupancyGrid& grid, int x0, int y0, int x1, int y1) {
+    walls = &grid;
+    x0 = std::max(x0, minX);
+    y0 = std::max(y0, minY);
+    x1 = std::min(x1, maxX);
+    y1 = std::min(y1, maxY);
+
+    // Refresh costs inside the changed area
+    std::vector<uint32_t>& raised = raisedScratch;
+    std::vector<uint32_t>& lowered = loweredScratch;
+    raised.clear();
+    lowered.clear();
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            if (!cells.hasChunk(x, y)) continue;
+            Cell& c = cells.cell(x, y);
+            uint16_t newCost = cellCost(grid, x, y);
+            if (newCost == c.cost) continue;
+            (newCost > c.cost ? raised : lowered).push_back(pack(x, y));
+            c.cost = newCost;
+        }
+    }
+    if (raised.empty() && lowered.empty()) return;
+
+    // Invalidate every cell whose distance may have been derived through a
+    // raised cell. Old distances are kept until the walk is finished.
+    std::vector<uint32_t>& invalidated = invalidatedScratch;
+    invalidated.clear();
+    for (uint32_t key : raised) {
+        Cell& c = cells.cell(unpackX(key), unpackY(key));
+        if (c.goal || c.dist == UNREACHABLE) continue;
+        c.flags |= INVALID;
+        invalidated.push_back(key);
+    }
+    for (size_t head = 0; head < invalidated.size(); ++head) {
+        int px = unpackX(invalidated[head]);
+        int py = unpackY(invalidated[head]);
+        uint32_t pd = cells.at(px, py).dist;
+        for (int k = 0; k < 8; ++k) {
+            int nx = px + NEIGHBOUR_DX[k];
+            int ny = py + NEIGHBOUR_DY[k];
+            if (!inPlayArea(nx, ny)) continue;
+
+            const Cell& n = cells.at(nx, ny);
+            if ((n.flags & INVALID) || n.goal || n.dist == UNREACHABLE || n.cost == BLOCKED) continue;
+            if (n.dist == pd + n.cost) {
+                cells.cell(nx, ny).flags |= INVALID;
+                invalidated.push_back(pack(nx, ny));
+            }
+        }
+    }
+    for (uint32_t key : invalidated) {
+        Cell& c = cells.cell(unpackX(key), unpackY(key));
+        dequeue(c);
+        c.dist = UNREACHABLE;
+    }
+
+    // Re-seed invalidated and cheaper cells from their final neighbours
+    frontierScratch.clear();
+    auto reseed = [&](uint32_t key) {
+        int x = unpackX(key);
+        int y = unpackY(key);
+        Cell& c = cells.cell(x, y);
+        if (c.goal || c.cost == BLOCKED) return;
+        uint32_t best = c.dist;
+        for (int k = 0; k < 8; ++k) {
+            int nx = x + NEIGHBOUR_DX[k];
+            int ny = y + NEIGHBOUR_DY[k];
+            if (!inPlayArea(nx, ny)) continue;
+
+            uint32_t nd = cells.at(nx, ny).dist;
+            if (nd < level && nd + c.cost < best) best = nd + c.cost;
+        }
+        if (best < c.dist) lower(c, key, best);
+    };
+    for (uint32_t key : invalidated) reseed(key);
+    for (uint32_t key : lowered) reseed(key);
+
+    for (uint32_t key : invalidated) cells.cell(unpackX(key), unpackY(key)).flags &= ~INVALID;
+
+    propagate();
+}
+
+/**
+ * @brief Travel cost from a cell to the target
+ */
+uint32_t FlowField::distanceAt(int x, int y) const {
+    if (!inPlayArea(x, y)) return UNREACHABLE;
+    return cells.at(x, y).dist;
+}
+
+/**
+ * @brief Check whether a cell can be entered
+ *
+ * Cells the search has not entered are costed from the walls directly.
+ */
+bool FlowField::isPassable(int x, int y) const {
+    if (!inPlayArea(x, y)) return false;
+    if (cells.hasChunk(x, y)) return cells.at(x, y).cost != BLOCKED;
+    return walls && cellCost(*walls, x, y) != BLOCKED;
+}
+
+/**
+ * @brief Best next cell from a position
+ *
+ * @param from Current position
+ * @return Neighbour with the lowest distance, or from itself if none is closer
+ */
+Position FlowField::nextStep(const Position& from) const {
+    Position best = from;
+    uint32_t bestDist = distanceAt(from.x, from.y);
+
+    for (int k = 0; k < 8; ++k) {
+        int nx = from.x + NEIGHBOUR_DX[k];
+        int ny = from.y + NEIGHBOUR_DY[k];
+        uint32_t nd = distanceAt(nx, ny);
+        if (nd < bestDist) {
+            bestDist = nd;
+            best = Position(nx, ny);
+        }
+    }
+    return best;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file FrameBuffer.cpp
+ * @brief Implementation of the double-buffered differential terminal renderer
+ */
+
+#include "FrameBuffer.h"
+#include <algorithm>
+#include <cerrno>
+#include <unistd.h>
+
+namespace {
+// Unchanged narrow cells this short are rewritten rather than jumped over,
+// since a cursor move costs more bytes than the characters themselves
+const int MAX_REWRITE_GAP = 4;
+}
+
+FrameBuffer::FrameBuffer(int columns, int rows)
+    : columns(columns), rows(rows),
+      front(static_cast<size_t>(columns) * rows),
+      back(static_cast<size_t>(columns) * rows),
+      lastFrameBytes(0), fullRedraw(true), outputFd(STDOUT_FILENO) {
+    clear();
+    invalidate();
+}
+
+/**
+ * @brief Reset the back buffer to spaces before composing a frame
+ */
+void FrameBuffer::clear() {
+    std::fill(back.begin(), back.end(), Cell{0, 1});
+}
+
+/**
+ * @brief Write a cell, blanking the other half of any wide glyph it splits
+ */
+void FrameBuffer::setCell(int x, int y, Cell cell) {
+    if (x < 0 || x >= columns || y < 0 || y >= rows) return;
+    Cell* row = &back[static_cast<size_t>(y) * columns];
+
+    if (row[x].glyph == CONTINUATION && x > 0) row[x - 1] = Cell{0, 1};
+    if (row[x].width == 2 && x + 1 < columns) row[x + 1] = Cell{0, 1};
+    row[x] = cell;
+}
+
+/**
+ * @brief Place one glyph at a cell; wide glyphs also cover the next cell
+ */
+void FrameBuffer::put(int x, int y, Glyph glyph) {
+    uint16_t id = static_cast<uint16_t>(glyph);
+    uint8_t width = static_cast<uint8_t>(GlyphTable::width(glyph));
+    --x;
+    --y;
+    // Off the buffer, or no room for a wide glyph's right half
+    if (x < 0 || y < 0 || y >= rows || x + width > columns) return;
+
+    setCell(x, y, Cell{id, width});
+    if (width == 2) {
+        setCell(x + 1, y, Cell{CONTINUATION, 0});
+        back[static_cast<size_t>(y) * columns + x] = Cell{id, width};
+    }
+}
+
+/**
+ * @brief Place a run of ASCII text starting at a cell, clipped to the buffer
+ */
+void FrameBuffer::putText(int x, int y, const std::string& text) {
+    for (size_t i = 0; i < text.size(); ++i) {
+        uint16_t id = static_cast<uint16_t>(GlyphTable::ascii(text[i]));
+        setCell(x - 1 + static_cast<int>(i), y - 1, Cell{id, 1});
+    }
+}
+
+/**
+ * @brief Append an absolute cursor move to the output buffer
+ */
+void FrameBuffer::moveCursor(int x, int y) {
+    output += "\033[";
+    output += std::to_string(y + 1);
+    output += ';';
+    output += std::to_string(x + 1);
+    output += 'H';
+}
+
+/**
+ * @brief Emit the difference with the previous frame and swap buffers
+ */
+void FrameBuffer::present(int cursorX, int cursorY) {
+    output.clear();
+    if (fullRedraw) output += "\033[H\033[2J";
+
+    for (int y = 0; y < rows; ++y) {
+        const Cell* next = &back[static_cast<size_t>(y) * columns];
+        const Cell* shown = &front[static_cast<size_t>(y) * columns];
+        int cursor = -1;  // Column the terminal cursor is at on this row, -1 if unknown
+
+        for (int x = 0; x < columns; ++x) {
+            if (next[x].glyph == CONTINUATION) continue;
+
+            bool changed = next[x] != shown[x] ||
+                           (next[x].width == 2 && x + 1 < columns && next[x + 1] != shown[x + 1]);
+            if (!changed) continue;
+
+            if (cursor != x) {
+                // Rewrite a short run of unchanged narrow cells instead of moving
+                bool rewrite = cursor >= 0 && x - cursor <= MAX_REWRITE_GAP;
+                for (int g = cursor; rewrite && g < x; ++g) {
+                    rewrite = next[g].width == 1 && next[g].glyph < ASCII_GLYPHS;
+                }
+                if (rewrite) {
+                    for (int g = cursor; g < x; ++g) output += static_cast<char>(' ' + next[g].glyph);
+                } else {
+                    moveCursor(x, y);
+                }
+            }
+            output += GlyphTable::bytes(static_cast<Glyph>(next[x].glyph));
+            cursor = x + next[x].width;
+        }
+    }
+    if (!output.empty()) moveCursor(cursorX - 1, cursorY - 1);
+
+    size_t written = 0;
+    while (outputFd >= 0 && written < output.size()) {
+        ssize_t n = write(outputFd, output.data() + written, output.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        written += static_cast<size_t>(n);
+    }
+
+    lastFrameBytes = output.size();
+    front.swap(back);
+    fullRedraw = false;
+}
+
+/**
+ * @brief Forget what the terminal shows; the next present() redraws everything
+ */
+void FrameBuffer::invalidate() {
+    std::fill(front.begin(), front.end(), Cell{UNKNOWN, 1});
+    fullRedraw = true;
+}
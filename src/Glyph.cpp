@@ -0,0 +1,114 @@
+/**
+ * @file Glyph.cpp
+ * @brief Glyph registry with precomputed UTF-8 bytes and display widths
+ */
+
+#include "Glyph.h"
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// UTF-8 of the named glyphs, in Glyph order
+const char* const GAME_GLYPHS[] = {
+    "👷", "🏰", "🧱", "🪨", "🪙", "💧", "🧪", "‼️ ", "🗡️", "💣", "🏹", "🧔🏾‍♂️",
+};
+
+struct Table {
+    std::vector<std::string> bytes;
+    std::vector<uint8_t> widths;
+    std::unordered_map<std::string, uint16_t> ids;
+
+    Table() {
+        for (char c = ' '; c <= '~'; ++c) add(std::string(1, c));
+        for (const char* glyph : GAME_GLYPHS) add(glyph);
+    }
+
+    uint16_t add(const std::string& glyph) {
+        uint16_t id = static_cast<uint16_t>(bytes.size());
+        bytes.push_back(glyph);
+        widths.push_back(static_cast<uint8_t>(GlyphTable::displayWidth(glyph)));
+        ids.emplace(glyph, id);
+        return id;
+    }
+};
+
+Table& table() {
+    static Table instance;
+    return instance;
+}
+
+// Decodes one UTF-8 code point starting at i and advances i
+uint32_t nextCodePoint(const std::string& s, size_t& i) {
+    unsigned char c = s[i];
+    int extra = c < 0x80 ? 0 : c < 0xE0 ? 1 : c < 0xF0 ? 2 : 3;
+    uint32_t cp = extra == 0 ? c : c & (0x3F >> extra);
+    ++i;
+    for (int k = 0; k < extra && i < s.size(); ++k, ++i) {
+        cp = (cp << 6) | (static_cast<unsigned char>(s[i]) & 0x3F);
+    }
+    return cp;
+}
+
+}
+
+/**
+ * @brief Id of a UTF-8 glyph, registering it on first use
+ */
+Glyph GlyphTable::intern(const std::string& utf8) {
+    Table& t = table();
+    auto it = t.ids.find(utf8);
+    return static_cast<Glyph>(it != t.ids.end() ? it->second : t.add(utf8));
+}
+
+/**
+ * @brief Check whether an id is in the table (ASCII, named or interned)
+ */
+bool GlyphTable::isKnown(Glyph glyph) {
+    return static_cast<uint16_t>(glyph) < table().bytes.size();
+}
+
+/**
+ * @brief UTF-8 bytes of a glyph; ids not in the table read as blank
+ */
+const std::string& GlyphTable::bytes(Glyph glyph) {
+    const Table& t = table();
+    uint16_t id = static_cast<uint16_t>(glyph);
+    return t.bytes[id < t.bytes.size() ? id : 0];
+}
+
+/**
+ * @brief Terminal columns a glyph occupies (1 or 2); 1 for ids not in the table
+ */
+int GlyphTable::width(Glyph glyph) {
+    const Table& t = table();
+    uint16_t id = static_cast<uint16_t>(glyph);
+    return t.widths[id < t.widths.size() ? id : 0];
+}
+
+/**
+ * @brief Number of terminal columns a UTF-8 glyph occupies
+ */
+int GlyphTable::displayWidth(const std::string& utf8) {
+    int width = 0;
+    bool afterJoiner = false;
+    size_t i = 0;
+    while (i < utf8.size()) {
+        uint32_t cp = nextCodePoint(utf8, i);
+        if (afterJoiner) {  // Joined code points render inside the previous one
+            afterJoiner = false;
+            continue;
+        }
+        if (cp == 0x200D) {
+            afterJoiner = true;
+        } else if (cp == 0xFE0E || cp == 0xFE0F || (cp >= 0x1F3FB && cp <= 0x1F3FF)) {
+            // Variation selectors and skin tone modifiers take no space
+        } else if (cp >= 0x1F000 || (cp >= 0x2600 && cp <= 0x27BF && i < utf8.size())) {
+            width += 2;  // Emoji; symbols count as emoji when a selector follows
+        } else {
+            width += 1;
+        }
+    }
+    return std::min(std::max(width, 1), 2);
+}
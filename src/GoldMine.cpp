@@ -19,7 +19,7 @@
  * @param x X-coordinate for mine placement
  * @param y Y-coordinate for mine placement
  */
-GoldMine::GoldMine(int x, int y) : ResourceGenerator(x, y, 7, 3, 0, 100, 100, 3, "🪨", 100) {}
+GoldMine::GoldMine(int x, int y) : ResourceGenerator(x, y, 7, 3, 0, 100, 100, 3, Glyph::ROCK, 100) {}
 
 /**
  * @brief Assignment operator for GoldMine
@@ -41,39 +41,24 @@ GoldMine& GoldMine::operator=(const GoldMine& other) {
         maxInstances = other.maxInstances;
         icon = other.icon;
         hasBorder = other.hasBorder;
+        id = other.id;
         
         // Copy ResourceGenerator properties
-        currentAmount = other.currentAmount;
+        fillStart = other.fillStart;
     }
     return *this;
 }
 
 /**
- * @brief Updates the gold mine's resource accumulation
- * 
- * Generates 5 gold per update until reaching capacity
- * Changes icon to "🪙" (coin) when full
+ * @brief Shows the "🪙" (coin) icon once the mine is full
  */
-void GoldMine::update() {
-    if (currentAmount < capacity) {
-        currentAmount += 5;
-        if (currentAmount >= capacity) {
-            icon = "🪙";  // Change to coin icon when full
-        }
-    }
+void GoldMine::showFull() {
+    icon = Glyph::COIN;
 }
 
 /**
- * @brief Collects accumulated gold from the mine
- * 
- * @return The amount of gold collected if mine is full, 0 otherwise
+ * @brief Shows the "🪨" (rock) icon after the mine is collected
  */
-int GoldMine::collect() {
-    if (currentAmount >= capacity) {
-        int collected = currentAmount;
-        currentAmount = 0;
-        icon = "🪨";  // Reset to rock icon after collection
-        return collected;
-    }
-    return 0;  // Nothing to collect yet
+void GoldMine::showEmpty() {
+    icon = Glyph::ROCK;
 }
@@ -1,13 +1,15 @@
 #include "InputManager.h"
-#include <cstdio>  
 #include <cctype>
+#include <cerrno>
 #include <unistd.h>
 #include <termios.h>
 InputManager::InputManager() {
     tcgetattr(STDIN_FILENO, &originalTerminalSettings);
     termios newSettings = originalTerminalSettings;
     newSettings.c_lflag &= ~(ICANON | ECHO);
-    newSettings.c_cc[VMIN] = 1;
+    // read() returns whatever is buffered, or nothing, without waiting;
+    // the event loop polls before reading
+    newSettings.c_cc[VMIN] = 0;
     newSettings.c_cc[VTIME] = 0;
     tcsetattr(STDIN_FILENO, TCSANOW, &newSettings);
 }
@@ -16,17 +18,47 @@ InputManager::~InputManager() {
     tcsetattr(STDIN_FILENO, TCSANOW, &originalTerminalSettings);
 }
 
-char InputManager::getInput() const {
-    char ch = getchar();
-    if (ch == 27) {
-        getchar();
-        ch = getchar();
-        switch(ch) {
-            case 'A': return 'U';
-            case 'B': return 'D';
-            case 'C': return 'R';
-            case 'D': return 'L';
+int InputManager::fd() const {
+    return STDIN_FILENO;
+}
+
+/* Reads everything waiting on stdin and decodes it into commands
+ * Arrow keys arrive as ESC [ A..D (or ESC O A..D); other escape
+ * sequences and a lone ESC are dropped
+ */
+bool InputManager::readCommands(std::vector<char>& commands) {
+    char buffer[256];
+    ssize_t n;
+    do {
+        n = read(STDIN_FILENO, buffer, sizeof(buffer));
+    } while (n < 0 && errno == EINTR);
+    if (n == 0) return false;  // Polled readable but empty: stdin is closed
+    if (n < 0) return errno == EAGAIN || errno == EWOULDBLOCK;
+
+    pending.append(buffer, static_cast<size_t>(n));
+    size_t i = 0;
+    while (i < pending.size()) {
+        char ch = pending[i];
+        if (ch != 27) {
+            commands.push_back(static_cast<char>(toupper(static_cast<unsigned char>(ch))));
+            ++i;
+            continue;
+        }
+
+        if (i + 1 >= pending.size()) break;  // Wait for the rest of the sequence
+        if (pending[i + 1] != '[' && pending[i + 1] != 'O') {
+            ++i;  // Lone ESC
+            continue;
+        }
+        if (i + 2 >= pending.size()) break;
+        switch (pending[i + 2]) {
+            case 'A': commands.push_back('U'); break;
+            case 'B': commands.push_back('D'); break;
+            case 'C': commands.push_back('R'); break;
+            case 'D': commands.push_back('L'); break;
         }
+        i += 3;
     }
-    return toupper(ch);
+    pending.erase(0, i);
+    return true;
 }
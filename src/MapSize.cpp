@@ -0,0 +1,15 @@
+#include "MapSize.h"
+#include <algorithm>
+#include <cstdio>
+
+MapSize MapSize::clamped() const {
+    return MapSize{ std::min(std::max(width, MIN_WIDTH), MAX_SIDE), std::min(std::max(height, MIN_HEIGHT), MAX_SIDE) };
+}
+
+bool MapSize::parse(const std::string& text, MapSize& size) {
+    int w, h;
+    char tail;
+    if (sscanf(text.c_str(), "%dx%d%c", &w, &h, &tail) != 2) return false;
+    size = MapSize{w, h};
+    return true;
+}
@@ -1,4 +0,0 @@
-#include "Npc.h"
-using namespace std;
-
-Npc::Npc(int x, int y, const string& icon) : Entity(x, y, icon) {}
@@ -0,0 +1,188 @@
+/**
+ * @file ObserverServer.cpp
+ * @brief Non-blocking Unix domain socket publisher of the observer stream
+ */
+
+#include "ObserverServer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// Writes never raise SIGPIPE and never block
+const int SEND_FLAGS = MSG_NOSIGNAL | MSG_DONTWAIT;
+
+bool wouldBlock(int error) { return error == EAGAIN || error == EWOULDBLOCK; }
+
+}
+
+ObserverServer::~ObserverServer() {
+    for (Client& client : clients) {
+        if (client.fd >= 0) close(client.fd);
+    }
+    if (listenFd >= 0) {
+        close(listenFd);
+        unlink(path.c_str());
+    }
+}
+
+/**
+ * @brief Start listening on a socket path
+ */
+bool ObserverServer::listen(const std::string& socketPath, std::string* error) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+        if (error) *error = "socket path is empty or too long";
+        return false;
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    // Only a socket is replaced, never a regular file given by mistake
+    struct stat info;
+    if (lstat(socketPath.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) unlink(socketPath.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0 || bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, 16) != 0) {
+        if (error) *error = std::strerror(errno);
+        if (fd >= 0) close(fd);
+        return false;
+    }
+    listenFd = fd;
+    path = socketPath;
+    return true;
+}
+
+/**
+ * @brief Accept every observer waiting to connect
+ */
+void ObserverServer::acceptClients() {
+    if (listenFd < 0) return;
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        clients.push_back(Client{fd, true, std::string(), 0});
+    }
+}
+
+/**
+ * @brief Send what is left of a client's last message
+ *
+ * @return true once nothing is pending
+ */
+bool ObserverServer::flush(Client& client) {
+    while (client.pendingOffset < client.pending.size()) {
+        ssize_t n = ::send(client.fd, client.pending.data() + client.pendingOffset,
+                           client.pending.size() - client.pendingOffset, SEND_FLAGS);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (!wouldBlock(errno)) {
+                close(client.fd);
+                client.fd = -1;
+            }
+            return false;
+        }
+        client.pendingOffset += static_cast<size_t>(n);
+        stats.bytes += static_cast<uint64_t>(n);
+    }
+    client.pending.clear();
+    client.pendingOffset = 0;
+    return true;
+}
+
+/**
+ * @brief Write a message with one gather write, keeping whatever did not fit
+ */
+void ObserverServer::send(Client& client, const std::vector<iovec>& message, size_t bytes) {
+    msghdr header{};
+    header.msg_iov = const_cast<iovec*>(message.data());
+    header.msg_iovlen = message.size();
+    ssize_t n;
+    do {
+        n = sendmsg(client.fd, &header, SEND_FLAGS);
+    } while (n < 0 && errno == EINTR);
+    if (n < 0) {
+        if (!wouldBlock(errno)) {
+            close(client.fd);
+            client.fd = -1;
+            return;
+        }
+        n = 0;
+    }
+    stats.bytes += static_cast<uint64_t>(n);
+    if (static_cast<size_t>(n) == bytes) return;
+
+    // The socket buffer is full: keep the rest of the message for the next publish
+    size_t skip = static_cast<size_t>(n);
+    client.pending.clear();
+    client.pendingOffset = 0;
+    for (const iovec& section : message) {
+        if (skip >= section.iov_len) {
+            skip -= section.iov_len;
+            continue;
+        }
+        client.pending.append(static_cast<const char*>(section.iov_base) + skip, section.iov_len - skip);
+        skip = 0;
+    }
+}
+
+void ObserverServer::dropClosed() {
+    clients.erase(std::remove_if(clients.begin(), clients.end(), [](const Client& client) { return client.fd < 0; }),
+                  clients.end());
+}
+
+/**
+ * @brief Send the board's changes since the last publish to every observer
+ *
+ * Observers that have not taken the rest of their previous message miss
+ * this one and wait for a keyframe. A delta is only encoded when some
+ * observer is in sync to apply it; otherwise the encoder's baseline goes
+ * stale, which is fine because the next message anyone can use is a
+ * keyframe.
+ */
+void ObserverServer::publish(const Board& board) {
+    if (publishesSinceKeyframe < KEYFRAME_INTERVAL) ++publishesSinceKeyframe;
+    if (clients.empty()) return;
+
+    bool wantsKeyframe = false;
+    bool wantsDelta = false;
+    for (Client& client : clients) {
+        if (!flush(client)) continue;
+        if (client.needsKeyframe) wantsKeyframe = true;
+        else wantsDelta = true;
+    }
+
+    bool keyframe = wantsKeyframe && publishesSinceKeyframe >= KEYFRAME_INTERVAL;
+    const std::vector<iovec>* message = nullptr;
+    if (keyframe) {
+        message = &encoder.encodeKeyframe(board);
+        publishesSinceKeyframe = 0;
+        ++stats.keyframes;
+    } else if (wantsDelta) {
+        message = &encoder.encodeDelta(board);
+        ++stats.deltas;
+    }
+
+    for (Client& client : clients) {
+        if (client.fd < 0) continue;
+        if (!client.pending.empty()) {
+            // Fell behind: this message is lost to it, so its state can only be rebuilt from a keyframe
+            client.needsKeyframe = true;
+            if (message) ++stats.skipped;
+            continue;
+        }
+        if (!message || (client.needsKeyframe && !keyframe)) continue;
+        client.needsKeyframe = false;
+        send(client, *message, encoder.getMessageBytes());
+    }
+    dropClosed();
+}
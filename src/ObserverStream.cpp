@@ -0,0 +1,394 @@
+/**
+ * @file ObserverStream.cpp
+ * @brief Observer stream encoding, decoding, and applying deltas to a board
+ */
+
+#include "ObserverStream.h"
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+
+namespace {
+
+static_assert(sizeof(StreamHeader) == 16, "stream layout changed; bump OBSERVER_STREAM_VERSION");
+static_assert(sizeof(DeltaHeader) == 104, "stream layout changed; bump OBSERVER_STREAM_VERSION");
+static_assert(sizeof(UnitPlace) == 8, "stream layout changed; bump OBSERVER_STREAM_VERSION");
+static_assert(sizeof(BuildingState) == 16, "stream layout changed; bump OBSERVER_STREAM_VERSION");
+
+const char PADDING[8] = {};
+
+size_t paddingFor(size_t bytes) { return (8 - bytes % 8) % 8; }
+
+UnitPlace unitPlace(uint32_t id, const Position& pos) {
+    return UnitPlace{id, static_cast<uint16_t>(pos.x), static_cast<uint16_t>(pos.y)};
+}
+
+BuildingState buildingState(const Building& building, BuildingKind kind) {
+    BuildingState state{};
+    state.id = building.getId();
+    state.kind = static_cast<uint8_t>(kind);
+    state.icon = static_cast<uint16_t>(building.getIcon());
+    state.health = building.getHealth();
+    state.x = static_cast<uint16_t>(building.getPosition().x);
+    state.y = static_cast<uint16_t>(building.getPosition().y);
+    return state;
+}
+
+// Bounds-checked cursor over a message payload
+struct PayloadReader {
+    const char* data;
+    size_t size;
+    size_t offset;
+
+    bool read(void* out, size_t bytes) {
+        if (bytes > size - offset) return false;
+        if (bytes > 0) std::memcpy(out, data + offset, bytes);
+        offset += bytes;
+        return true;
+    }
+
+    template<typename T>
+    bool read(std::vector<T>& values, size_t n) {
+        static_assert(std::is_trivially_copyable<T>::value, "sections are copied as bytes");
+        if (n > (size - offset) / sizeof(T)) return false;
+        values.resize(n);
+        return read(values.data(), n * sizeof(T));
+    }
+};
+
+// Dense index of a unit id in an archetype, or -1; ids are kept in increasing order
+long indexOfUnit(const UnitArchetype& archetype, uint32_t id) {
+    auto it = std::lower_bound(archetype.id.begin(), archetype.id.end(), id);
+    if (it == archetype.id.end() || *it != id) return -1;
+    return static_cast<long>(it - archetype.id.begin());
+}
+
+template<typename T>
+void indexBuildings(const SlotMap<T>& buildings, BuildingKind kind,
+                    std::unordered_map<uint32_t, BuildingHandle>& byId) {
+    for (size_t i = 0; i < buildings.size(); ++i) {
+        byId[buildings[i].getId()] = BuildingHandle{kind, buildings.handleAt(i)};
+    }
+}
+
+}
+
+/**
+ * @brief Split a DELTA payload into its sections
+ */
+bool decodeDelta(uint64_t tick, const char* payload, size_t bytes, ObservedDelta& delta) {
+    PayloadReader reader{payload, bytes, 0};
+    delta.tick = tick;
+    if (!reader.read(&delta.header, sizeof(DeltaHeader))) return false;
+    const DeltaHeader& header = delta.header;
+    for (int k = 0; k < UNIT_KIND_COUNT; ++k) {
+        if (!reader.read(delta.moved[k], header.moved[k]) || !reader.read(delta.spawned[k], header.spawned[k]) ||
+            !reader.read(delta.died[k], header.died[k])) {
+            return false;
+        }
+    }
+    if (!reader.read(delta.changed, header.buildingsChanged) || !reader.read(delta.added, header.buildingsAdded) ||
+        !reader.read(delta.removed, header.buildingsRemoved)) {
+        return false;
+    }
+    delta.status.clear();
+    if (header.statusChanged) {
+        if (header.statusBytes > bytes - reader.offset) return false;
+        delta.status.assign(payload + reader.offset, header.statusBytes);
+        reader.offset += header.statusBytes;
+    }
+    return bytes - reader.offset < 8;
+}
+
+/**
+ * @brief Split a KEYFRAME payload into its status text and snapshot bytes
+ */
+bool decodeKeyframe(const char* payload, size_t bytes, std::string& status, const char*& snapshot,
+                    size_t& snapshotBytes) {
+    uint32_t prefix[2];
+    PayloadReader reader{payload, bytes, 0};
+    if (!reader.read(prefix, sizeof(prefix))) return false;
+    size_t statusSpan = prefix[0] + paddingFor(prefix[0]);
+    if (statusSpan > bytes - reader.offset) return false;
+    status.assign(payload + reader.offset, prefix[0]);
+    snapshot = payload + reader.offset + statusSpan;
+    snapshotBytes = bytes - reader.offset - statusSpan;
+    return true;
+}
+
+/**
+ * @brief Merge each archetype against its baseline, collecting moves, spawns and deaths
+ */
+void ObserverEncoder::diffUnits(const UnitStore& units, bool record) {
+    for (int k = 0; k < UNIT_KIND_COUNT; ++k) {
+        const UnitArchetype& archetype = units.of(static_cast<UnitKind>(k));
+        std::vector<uint32_t>& baseIds = ids[k];
+        std::vector<Position>& basePositions = positions[k];
+        moved[k].clear();
+        spawned[k].clear();
+        died[k].clear();
+
+        if (record) {
+            size_t i = 0, j = 0;
+            while (i < archetype.size() || j < baseIds.size()) {
+                if (j == baseIds.size() || (i < archetype.size() && archetype.id[i] < baseIds[j])) {
+                    spawned[k].push_back(unitPlace(archetype.id[i], archetype.position[i]));
+                    ++i;
+                } else if (i == archetype.size() || baseIds[j] < archetype.id[i]) {
+                    died[k].push_back(baseIds[j]);
+                    ++j;
+                } else {
+                    if (!(archetype.position[i] == basePositions[j])) {
+                        moved[k].push_back(unitPlace(archetype.id[i], archetype.position[i]));
+                    }
+                    ++i;
+                    ++j;
+                }
+            }
+        }
+        baseIds.assign(archetype.id.begin(), archetype.id.end());
+        basePositions.assign(archetype.position.begin(), archetype.position.end());
+    }
+}
+
+/**
+ * @brief Compare one kind of building against the baseline and update it
+ */
+template<typename T>
+void ObserverEncoder::diffBuildings(const SlotMap<T>& buildings, BuildingKind kind, bool record) {
+    for (size_t i = 0; i < buildings.size(); ++i) {
+        const T& building = buildings[i];
+        uint32_t id = building.getId();
+        if (id >= buildingById.size()) buildingById.resize(std::max<size_t>(id + 1, buildingById.size() * 2));
+        BuildingBaseline& base = buildingById[id];
+        uint16_t icon = static_cast<uint16_t>(building.getIcon());
+        int32_t health = building.getHealth();
+        if (record) {
+            if (base.kind == static_cast<uint8_t>(BuildingKind::NONE)) {
+                added.push_back(buildingState(building, kind));
+            } else if (base.icon != icon || base.health != health) {
+                changed.push_back(buildingState(building, kind));
+            }
+        }
+        base.kind = static_cast<uint8_t>(kind);
+        base.icon = icon;
+        base.health = health;
+        base.seen = pass;
+        nextBuildingIds.push_back(id);
+    }
+}
+
+/**
+ * @brief Drop baseline buildings the last pass did not find
+ */
+void ObserverEncoder::finishBuildings(bool record) {
+    for (uint32_t id : buildingIds) {
+        BuildingBaseline& base = buildingById[id];
+        if (base.seen == pass) continue;
+        if (record) {
+            BuildingState state{};
+            state.id = id;
+            state.kind = base.kind;
+            removed.push_back(state);
+        }
+        base.kind = static_cast<uint8_t>(BuildingKind::NONE);
+    }
+    buildingIds.swap(nextBuildingIds);
+    nextBuildingIds.clear();
+}
+
+/**
+ * @brief Diff the board against the baseline and make it the new baseline
+ *
+ * @param record Whether to collect the differences (false for keyframes)
+ */
+void ObserverEncoder::diff(const Board& board, bool record) {
+    ++pass;
+    diffUnits(board.getUnits(), record);
+    changed.clear();
+    added.clear();
+    removed.clear();
+    diffBuildings(board.getWalls(), BuildingKind::WALL, record);
+    diffBuildings(board.getGoldMines(), BuildingKind::GOLD_MINE, record);
+    diffBuildings(board.getElixirCollectors(), BuildingKind::ELIXIR_COLLECTOR, record);
+    finishBuildings(record);
+}
+
+void ObserverEncoder::addSection(const void* data, size_t bytes) {
+    if (bytes == 0) return;
+    iov.push_back(iovec{const_cast<void*>(data), bytes});
+    messageBytes += bytes;
+}
+
+/**
+ * @brief Encode the whole board and make it the baseline
+ */
+const std::vector<iovec>& ObserverEncoder::encodeKeyframe(const Board& board) {
+    diff(board, false);
+    status = board.getStatusMessage();
+
+    uint32_t prefix[2] = { static_cast<uint32_t>(status.size()), 0 };
+    keyframe.clear();
+    keyframe.append(reinterpret_cast<const char*>(prefix), sizeof(prefix));
+    keyframe.append(status);
+    keyframe.append(PADDING, paddingFor(status.size()));
+    board.writeSnapshot(keyframe, false);
+
+    header = StreamHeader{OBSERVER_STREAM_VERSION, static_cast<uint16_t>(StreamMessage::KEYFRAME),
+                          static_cast<uint32_t>(keyframe.size()), board.getTick()};
+    iov.clear();
+    messageBytes = 0;
+    addSection(&header, sizeof(header));
+    addSection(keyframe.data(), keyframe.size());
+    return iov;
+}
+
+/**
+ * @brief Encode what changed since the baseline and make the board the new baseline
+ */
+const std::vector<iovec>& ObserverEncoder::encodeDelta(const Board& board) {
+    diff(board, true);
+
+    delta = DeltaHeader{};
+    delta.playerX = board.getPlayer().getPosition().x;
+    delta.playerY = board.getPlayer().getPosition().y;
+    delta.gold = board.getPlayer().getResources().gold;
+    delta.elixir = board.getPlayer().getResources().elixir;
+    delta.townhallHealth = board.getTownHall().getHealth();
+    for (int k = 0; k < UNIT_KIND_COUNT; ++k) {
+        delta.unitCounters[k] = board.getUnitCounter(static_cast<UnitKind>(k));
+        delta.moved[k] = static_cast<uint32_t>(moved[k].size());
+        delta.spawned[k] = static_cast<uint32_t>(spawned[k].size());
+        delta.died[k] = static_cast<uint32_t>(died[k].size());
+    }
+    delta.buildingsChanged = static_cast<uint32_t>(changed.size());
+    delta.buildingsAdded = static_cast<uint32_t>(added.size());
+    delta.buildingsRemoved = static_cast<uint32_t>(removed.size());
+    delta.gameOver = board.isGameOver() ? 1 : 0;
+    if (board.getStatusMessage() != status) {
+        status = board.getStatusMessage();
+        delta.statusChanged = 1;
+        delta.statusBytes = static_cast<uint32_t>(status.size());
+    }
+
+    iov.clear();
+    messageBytes = 0;
+    addSection(&header, sizeof(header));
+    addSection(&delta, sizeof(delta));
+    for (int k = 0; k < UNIT_KIND_COUNT; ++k) {
+        addSection(moved[k].data(), moved[k].size() * sizeof(UnitPlace));
+        addSection(spawned[k].data(), spawned[k].size() * sizeof(UnitPlace));
+        addSection(died[k].data(), died[k].size() * sizeof(uint32_t));
+    }
+    addSection(changed.data(), changed.size() * sizeof(BuildingState));
+    addSection(added.data(), added.size() * sizeof(BuildingState));
+    addSection(removed.data(), removed.size() * sizeof(BuildingState));
+    if (delta.statusChanged) addSection(status.data(), status.size());
+    addSection(PADDING, paddingFor(messageBytes));
+
+    header = StreamHeader{OBSERVER_STREAM_VERSION, static_cast<uint16_t>(StreamMessage::DELTA),
+                          static_cast<uint32_t>(messageBytes - sizeof(StreamHeader)), board.getTick()};
+    return iov;
+}
+
+/**
+ * @brief Bring an observer's copy of a board up to date with a delta
+ *
+ * Deaths are applied before moves and spawns, since spawned ids are
+ * always larger than any id already in an archetype and appending keeps
+ * the archetypes in id order. Everything read from the stream is checked
+ * before any of it is applied.
+ */
+bool Board::applyObservedDelta(const ObservedDelta& delta) {
+    const DeltaHeader& header = delta.header;
+    if (!isOnMap(Position(header.playerX, header.playerY))) return false;
+    for (int k = 0; k < UNIT_KIND_COUNT; ++k) {
+        for (const auto* places : { &delta.moved[k], &delta.spawned[k] }) {
+            for (const UnitPlace& place : *places) {
+                if (!isOnMap(Position(place.x, place.y))) return false;
+            }
+        }
+    }
+    for (const BuildingState& state : delta.changed) {
+        if (!GlyphTable::isKnown(static_cast<Glyph>(state.icon))) return false;
+    }
+    for (const BuildingState& state : delta.added) {
+        if (!GlyphTable::isKnown(static_cast<Glyph>(state.icon))) return false;
+        bool onMap = true;
+        switch (static_cast<BuildingKind>(state.kind)) {
+            case BuildingKind::WALL: onMap = isOnMap(Wall(state.x, state.y)); break;
+            case BuildingKind::GOLD_MINE: onMap = isOnMap(GoldMine(state.x, state.y)); break;
+            case BuildingKind::ELIXIR_COLLECTOR: onMap = isOnMap(ElixirCollector(state.x, state.y)); break;
+            default: break;  // Skipped when applied
+        }
+        if (!onMap) return false;
+    }
+
+    rng = Rng(rng.getSeed(), delta.tick);
+    player.setPosition(header.playerX, header.playerY);
+    player.getResources().gold = header.gold;
+    player.getResources().elixir = header.elixir;
+    buildings.townhall.setHealth(header.townhallHealth);
+    std::copy(header.unitCounters, header.unitCounters + UNIT_KIND_COUNT, unitCounters);
+    gameOver = header.gameOver != 0;
+    if (header.statusChanged) statusMessage = delta.status;
+
+    for (int k = 0; k < UNIT_KIND_COUNT; ++k) {
+        UnitArchetype& archetype = units.of(static_cast<UnitKind>(k));
+        if (!delta.died[k].empty()) {
+            for (uint32_t id : delta.died[k]) {
+                long i = indexOfUnit(archetype, id);
+                if (i >= 0) archetype.health[i] = 0;
+            }
+            archetype.removeDead();
+        }
+        for (const UnitPlace& place : delta.moved[k]) {
+            long i = indexOfUnit(archetype, place.id);
+            if (i >= 0) archetype.position[i] = Position(place.x, place.y);
+        }
+        for (const UnitPlace& place : delta.spawned[k]) {
+            archetype.add(place.id, Position(place.x, place.y));
+            if (place.id >= units.getNextId()) units.setNextId(place.id + 1);
+        }
+    }
+
+    if (!delta.changed.empty() || !delta.removed.empty()) {
+        std::unordered_map<uint32_t, BuildingHandle> byId;
+        indexBuildings(buildings.walls, BuildingKind::WALL, byId);
+        indexBuildings(buildings.goldMines, BuildingKind::GOLD_MINE, byId);
+        indexBuildings(buildings.elixirCollectors, BuildingKind::ELIXIR_COLLECTOR, byId);
+        for (const BuildingState& state : delta.changed) {
+            auto it = byId.find(state.id);
+            Building* building = it != byId.end() ? buildings.get(it->second) : nullptr;
+            if (!building) continue;
+            building->setHealth(state.health);
+            building->setIcon(static_cast<Glyph>(state.icon));
+        }
+        for (const BuildingState& state : delta.removed) {
+            auto it = byId.find(state.id);
+            Building* building = it != byId.end() ? buildings.get(it->second) : nullptr;
+            if (!building) continue;
+            occupancy.remove(*building);
+            buildings.remove(it->second);
+        }
+    }
+
+    for (const BuildingState& state : delta.added) {
+        BuildingHandle handle;
+        BuildingKind kind = static_cast<BuildingKind>(state.kind);
+        switch (kind) {
+            case BuildingKind::WALL: handle = buildings.add(Wall(state.x, state.y)); break;
+            case BuildingKind::GOLD_MINE: handle = buildings.add(GoldMine(state.x, state.y)); break;
+            case BuildingKind::ELIXIR_COLLECTOR: handle = buildings.add(ElixirCollector(state.x, state.y)); break;
+            default: continue;
+        }
+        Building* building = buildings.get(handle);
+        building->setId(state.id);
+        building->setHealth(state.health);
+        building->setIcon(static_cast<Glyph>(state.icon));
+        occupancy.place(*building, kind, handle.slot);
+        nextBuildingId = std::max(nextBuildingId, state.id + 1);
+    }
+    return true;
+}
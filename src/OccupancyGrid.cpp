@@ -0,0 +1,82 @@
+/**
+ * @file OccupancyGrid.cpp
+ * @brief Implementation of the cell-indexed building occupancy grid
+ */
+
+#include "OccupancyGrid.h"
+#include <algorithm>
+
+OccupancyGrid::OccupancyGrid(int width, int height)
+    : width(width), height(height), cells(width, height, Occupant{0, BuildingKind::NONE, SlotHandle()}) {}
+
+/**
+ * @brief Mark the footprint of a building as occupied
+ *
+ * The footprint is clipped to the grid.
+ *
+ * @param building Building to stamp
+ * @param kind Kind recorded for each covered cell
+ * @param slot Slot of the building in its store
+ */
+void OccupancyGrid::place(const Building& building, BuildingKind kind, SlotHandle slot) {
+    const Position& pos = building.getPosition();
+    int x0 = std::max(pos.x, 0);
+    int y0 = std::max(pos.y, 0);
+    int x1 = std::min(pos.x + building.getSizeX(), width);
+    int y1 = std::min(pos.y + building.getSizeY(), height);
+
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            cells.cell(x, y) = Occupant{building.getId(), kind, slot};
+        }
+    }
+}
+
+/**
+ * @brief Clear the footprint of a building
+ *
+ * @param building Building being removed
+ */
+void OccupancyGrid::remove(const Building& building) {
+    const Position& pos = building.getPosition();
+    int x0 = std::max(pos.x, 0);
+    int y0 = std::max(pos.y, 0);
+    int x1 = std::min(pos.x + building.getSizeX(), width);
+    int y1 = std::min(pos.y + building.getSizeY(), height);
+
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            if (cells.at(x, y).id == building.getId()) cells.cell(x, y) = Occupant{0, BuildingKind::NONE, SlotHandle()};
+        }
+    }
+}
+
+/**
+ * @brief Get the occupant of a cell
+ *
+ * @return Occupant, or an empty occupant for cells off the grid
+ */
+Occupant OccupancyGrid::at(int x, int y) const {
+    if (!inBounds(x, y)) return Occupant{0, BuildingKind::NONE, SlotHandle()};
+    return cells.at(x, y);
+}
+
+/**
+ * @brief Check whether a rectangle is free of buildings
+ *
+ * @return true if no cell in the rectangle belongs to another building
+ */
+bool OccupancyGrid::isAreaFree(int x, int y, int sizeX, int sizeY, uint32_t ignoreId) const {
+    int x0 = std::max(x, 0);
+    int y0 = std::max(y, 0);
+    int x1 = std::min(x + sizeX, width);
+    int y1 = std::min(y + sizeY, height);
+
+    for (int cy = y0; cy < y1; ++cy) {
+        for (int cx = x0; cx < x1; ++cx) {
+            uint32_t id = cells.at(cx, cy).id;
+            if (id != 0 && id != ignoreId) return false;
+        }
+    }
+    return true;
+}
@@ -16,7 +16,7 @@
  * @param x Initial X-coordinate
  * @param y Initial Y-coordinate
  */
-Player::Player(int x, int y) : Entity(x, y, "👷"), resources(400, 400) {}
+Player::Player(int x, int y) : Entity(x, y, Glyph::PLAYER), resources(400, 400) {}
 
 /**
  * @brief Get mutable reference to player's resources
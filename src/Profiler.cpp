@@ -0,0 +1,129 @@
+/**
+ * @file Profiler.cpp
+ * @brief Aggregation of the per-thread tick timers and counters
+ */
+
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+const char* const METRIC_NAMES[METRIC_COUNT] = {
+    "tick",
+    "spawn",
+    "enemies",
+    "troops",
+    "resources",
+    "findTarget",
+    "distances",
+    "bld erased",
+    "pool grows",
+    "spawned",
+};
+
+// Shared state, created on first use so thread_local constructors can rely on it
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadMetrics*> threads;
+    uint64_t retired[METRIC_COUNT] = {};   // Values of threads that have exited
+    uint64_t totals[METRIC_COUNT] = {};    // Running totals at the last endTick()
+    uint64_t last[METRIC_COUNT] = {};
+    uint64_t worst[METRIC_COUNT] = {};
+    uint64_t ticks = 0;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+}
+
+thread_local ThreadMetrics Profiler::local;
+
+ThreadMetrics::ThreadMetrics() {
+    for (auto& value : values) value.store(0, std::memory_order_relaxed);
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.threads.push_back(this);
+}
+
+ThreadMetrics::~ThreadMetrics() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (int m = 0; m < METRIC_COUNT; ++m) r.retired[m] += values[m].load(std::memory_order_relaxed);
+    r.threads.erase(std::remove(r.threads.begin(), r.threads.end(), this), r.threads.end());
+}
+
+/**
+ * @brief Close the current tick: compute its values and track the slowest one
+ */
+void Profiler::endTick() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    for (int m = 0; m < METRIC_COUNT; ++m) {
+        uint64_t sum = r.retired[m];
+        for (const ThreadMetrics* thread : r.threads) sum += thread->values[m].load(std::memory_order_relaxed);
+        r.last[m] = sum - r.totals[m];
+        r.totals[m] = sum;
+    }
+    ++r.ticks;
+
+    const int tick = static_cast<int>(Metric::TICK_NS);
+    if (r.last[tick] > r.worst[tick]) std::copy(r.last, r.last + METRIC_COUNT, r.worst);
+}
+
+uint64_t Profiler::lastTick(Metric metric) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.last[static_cast<int>(metric)];
+}
+
+uint64_t Profiler::worstTick(Metric metric) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.worst[static_cast<int>(metric)];
+}
+
+uint64_t Profiler::total(Metric metric) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.totals[static_cast<int>(metric)];
+}
+
+uint64_t Profiler::tickCount() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.ticks;
+}
+
+const char* Profiler::name(Metric metric) {
+    return METRIC_NAMES[static_cast<int>(metric)];
+}
+
+/**
+ * @brief Write totals, per-tick averages and the slowest tick to a file
+ *
+ * @return false if the file could not be written
+ */
+bool Profiler::dump(const std::string& path) {
+    FILE* out = std::fopen(path.c_str(), "w");
+    if (!out) return false;
+
+    uint64_t ticks = tickCount();
+    std::fprintf(out, "ticks %llu%s\n", static_cast<unsigned long long>(ticks),
+                 enabled() ? "" : " (profiling compiled out)");
+    std::fprintf(out, "%-12s %16s %14s %14s\n", "metric", "total", "per tick", "worst tick");
+    for (int m = 0; m < METRIC_COUNT; ++m) {
+        Metric metric = static_cast<Metric>(m);
+        uint64_t sum = total(metric);
+        std::fprintf(out, "%-12s %16llu %14.1f %14llu%s\n", name(metric),
+                     static_cast<unsigned long long>(sum), ticks ? static_cast<double>(sum) / ticks : 0.0,
+                     static_cast<unsigned long long>(worstTick(metric)), isTime(metric) ? " ns" : "");
+    }
+    return std::fclose(out) == 0;
+}
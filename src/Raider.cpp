@@ -1,69 +1,36 @@
 /**
  * @file Raider.cpp
- * @brief Implementation of the Raider enemy class
+ * @brief Targeting rules of the Raider enemy
  */
 
 #include "Raider.h"
-#include <cmath>
+#include "EnemySystem.h"
 
 /**
- * @brief Constructor for Raider enemy
- * 
- * Creates a Raider with:
- * - Icon: "🗡️" (sword)
- * - Damage: 15 points per attack
- * - Speed: 12 (faster than Bomberman)
- * 
- * @param x Initial X-coordinate
- * @param y Initial Y-coordinate
- */
-Raider::Raider(int x, int y)
-    : Enemy(x, y, EnemyType::RAIDER, "🗡️", 15, 12) {}
-
-/**
- * @brief Find target for Raider
+ * @brief Find target for a Raider
  * 
  * Raiders attack any building except walls: prioritizing resource buildings and townhall
  * 
- * @param walls Vector of walls (ignored by Raiders)
- * @param goldMines Vector of gold mines (high priority)
- * @param elixirCollectors Vector of elixir collectors (high priority)
- * @param townhall Town hall reference (attacked if closest)
- * @return Pointer to the closest building to attack, or nullptr if no building is in range
+ * @param myPos Position of the Raider
+ * @param buildings Buildings to choose from (walls are ignored)
+ * @return Handle of the closest building to attack, or none if no building is in range
  */
-Building* Raider::findTarget(vector<Wall>& walls, vector<GoldMine>& goldMines,
-                          vector<ElixirCollector>& elixirCollectors, const TownHall& townhall) {
+BuildingHandle UnitType<UnitKind::RAIDER>::findTarget(const Position& myPos, const BuildingStore& buildings) {
     // Raiders only target resources and townhall, never walls
-    Building* closestTarget = nullptr;
-    double minDist = 1000000;  // Large initial value
-    Position myPos = getPosition();
-    
-    // Check gold mines first (high priority)
-    for (auto& mine : goldMines) {
-        double dist = calculateDistance(myPos, mine.getPosition());
-        if (dist < minDist) {
-            minDist = dist;
-            closestTarget = &mine;
-        }
-    }
+    BuildingHandle closestTarget;
+    int minDist = ATTACK_REACH_SQUARED;
     
-    // Check elixir collectors (high priority)
-    for (auto& collector : elixirCollectors) {
-        double dist = calculateDistance(myPos, collector.getPosition());
-        if (dist < minDist) {
-            minDist = dist;
-            closestTarget = &collector;
-        }
-    }
+    // Gold mines first, then elixir collectors: earlier kinds win ties
+    closerTarget(myPos, BuildingKind::GOLD_MINE, buildings.goldMines, buildings.goldMineBoxes, closestTarget, minDist);
+    closerTarget(myPos, BuildingKind::ELIXIR_COLLECTOR, buildings.elixirCollectors, buildings.elixirCollectorBoxes,
+                 closestTarget, minDist);
     
     // Check town hall (will attack if it's closest)
-    double dist_th = calculateDistance(myPos, townhall.getPosition());
-    if (dist_th < minDist) {
-        minDist = dist_th;
-        closestTarget = const_cast<TownHall*>(&townhall);
+    if (squaredDistance(myPos, buildings.townhall.closestPointTo(myPos)) < minDist) {
+        closestTarget = buildings.townhallHandle();
     }
     
     // Raiders completely ignore walls - no wall checking code here
     
-    return (minDist < 2) ? closestTarget : nullptr;
+    return closestTarget;
 }
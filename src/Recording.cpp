@@ -0,0 +1,128 @@
+/**
+ * @file Recording.cpp
+ * @brief Text format for recorded game sessions
+ */
+
+#include "Recording.h"
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+namespace {
+// Version 2 added the spawn table; the end digests of version 1 files were
+// taken over an older snapshot layout and can no longer be checked
+const int RECORDING_VERSION = 2;
+}
+
+Recording::Recording(uint64_t seed, MapSize size, SpawnTable waves)
+    : seed(seed), size(size), waves(std::move(waves)), finished(false), endTick(0), endDigest(0) {}
+
+void Recording::add(uint64_t tick, uint64_t ms, char command) {
+    commands.push_back(RecordedCommand{tick, ms, command});
+}
+
+void Recording::finish(uint64_t tick, uint64_t digest) {
+    finished = true;
+    endTick = tick;
+    endDigest = digest;
+}
+
+/**
+ * @brief Write the recording to a file
+ */
+bool Recording::save(const std::string& path) const {
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file) return false;
+
+    fprintf(file, "VILLREC %d\nseed %" PRIu64 "\nmap %dx%d\n", RECORDING_VERSION, seed, size.width, size.height);
+    fprintf(file, "waves %zu\n", waves.size());
+    for (const WaveSpec& spec : waves) fprintf(file, "%s\n", formatWave(spec).c_str());
+    for (const auto& entry : commands) {
+        fprintf(file, "%" PRIu64 " %" PRIu64 " %c\n", entry.tick, entry.ms, entry.command);
+    }
+    if (finished) fprintf(file, "end %" PRIu64 " %016" PRIx64 "\n", endTick, endDigest);
+
+    bool ok = !ferror(file);
+    return fclose(file) == 0 && ok;
+}
+
+/**
+ * @brief Read a recording written by save()
+ */
+bool Recording::load(const std::string& path, std::string* error) {
+    FILE* file = fopen(path.c_str(), "r");
+    if (!file) {
+        if (error) *error = strerror(errno);
+        return false;
+    }
+
+    *this = Recording();
+    std::string problem;
+    int version = 0;
+    char line[512];
+    if (fscanf(file, "VILLREC %d ", &version) != 1 || version != RECORDING_VERSION) {
+        problem = "not a version " + std::to_string(RECORDING_VERSION) + " recording";
+    } else if (fscanf(file, "seed %" SCNu64 " ", &seed) != 1) {
+        problem = "missing seed";
+    }
+    int lineNumber = 2;
+    if (problem.empty()) {
+        long start = ftell(file);
+        int width, height;
+        if (fscanf(file, "map %dx%d ", &width, &height) == 2) {
+            size = MapSize{width, height};
+            ++lineNumber;
+        } else {
+            fseek(file, start, SEEK_SET);
+        }
+    }
+    if (problem.empty()) {
+        long start = ftell(file);
+        size_t rows;
+        if (fscanf(file, "waves %zu ", &rows) == 1) {
+            ++lineNumber;
+            waves.clear();
+            for (size_t i = 0; i < rows && problem.empty(); ++i) {
+                WaveSpec spec;
+                std::string reason;
+                ++lineNumber;
+                if (!fgets(line, sizeof(line), file)) {
+                    problem = "missing wave on line " + std::to_string(lineNumber);
+                } else if (!parseWave(line, spec, &reason)) {
+                    problem = reason + " on line " + std::to_string(lineNumber);
+                } else {
+                    waves.push_back(spec);
+                }
+            }
+        } else {
+            fseek(file, start, SEEK_SET);
+        }
+    }
+
+    while (problem.empty() && fgets(line, sizeof(line), file)) {
+        ++lineNumber;
+        RecordedCommand entry;
+        uint64_t tick, digest;
+        if (sscanf(line, "end %" SCNu64 " %" SCNx64, &tick, &digest) == 2) {
+            finish(tick, digest);
+            break;
+        }
+        if (sscanf(line, "%" SCNu64 " %" SCNu64 " %c", &entry.tick, &entry.ms, &entry.command) != 3 ||
+            (!commands.empty() && entry.tick < commands.back().tick)) {
+            problem = "bad command on line " + std::to_string(lineNumber);
+            break;
+        }
+        commands.push_back(entry);
+    }
+    if (problem.empty() && !finished) problem = "recording has no end state";
+    if (problem.empty() && !commands.empty() && commands.back().tick > endTick) problem = "command after the end state";
+    fclose(file);
+
+    if (!problem.empty()) {
+        if (error) *error = problem;
+        return false;
+    }
+    return true;
+}
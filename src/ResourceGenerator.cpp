@@ -1,6 +1,31 @@
 #include "ResourceGenerator.h"
 using namespace std;
 ResourceGenerator::ResourceGenerator(int x, int y, int sizeX, int sizeY, int costGold, int costElixir,
-                     int health, int maxInstances, const string& icon, int capacity)
+                     int health, int maxInstances, Glyph icon, int capacity)
     : Building(x, y, sizeX, sizeY, costGold, costElixir, health, maxInstances, icon),
-      currentAmount(0), capacity(capacity) {}
+      fillStart(0), capacity(capacity) {}
+
+/**
+ * @brief Amount stored once tick ticks have completed
+ *
+ * Grows by RATE per tick since fillStart, capped at capacity.
+ */
+int ResourceGenerator::amountAt(uint64_t tick) const {
+    if (tick <= fillStart) return 0;
+    uint64_t produced = (tick - fillStart) * RATE;
+    return produced >= static_cast<uint64_t>(capacity) ? capacity : static_cast<int>(produced);
+}
+
+/**
+ * @brief Takes the stored amount if the generator is full and starts refilling
+ *
+ * @param tick Current tick
+ * @return The amount collected if full, 0 otherwise
+ */
+int ResourceGenerator::collect(uint64_t tick) {
+    int amount = amountAt(tick);
+    if (amount < capacity) return 0;  // Nothing to collect yet
+    fillStart = tick;
+    showEmpty();
+    return amount;
+}
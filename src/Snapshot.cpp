@@ -0,0 +1,449 @@
+/**
+ * @file Snapshot.cpp
+ * @brief Versioned binary world snapshots, loaded through mmap
+ *
+ * Layout (all integers little-endian, every section 8-byte aligned):
+ *
+ *   SnapshotHeader
+ *   WaveSpec spawn table[waveCount]
+ *   BuildingRecord[wallCount], [goldMineCount], [elixirCollectorCount]
+ *   if hasFlowFields, for the avoid-walls field and then the wall-cost field:
+ *     FlowFieldRecord, uint32_t chunk ids[chunkCount],
+ *     uint32_t distances[chunkCount * CHUNK_CELLS]
+ *   per unit kind, for unitCounts[kind] units:
+ *     uint32_t id[], Position position[], int32_t health[], damage[],
+ *     speedCounter[], TargetRecord target[]
+ *
+ * The unit arrays are the archetype's component arrays byte for byte, so
+ * loading them is a copy. Building targets are stored as dense indices
+ * and turned back into handles on load. A flow field stores only the
+ * chunks its search has entered, so its size follows the area between
+ * the Town Hall and the enemies rather than the map.
+ */
+
+#include "World.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <utility>
+#include <unistd.h>
+
+namespace {
+
+const char SNAPSHOT_MAGIC[8] = { 'V', 'I', 'L', 'L', 'S', 'N', 'A', 'P' };
+
+// Bump whenever the layout below changes; older files are rejected
+const uint32_t SNAPSHOT_VERSION = 3;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t seed;
+    uint64_t tick;
+    int32_t width, height;
+    int32_t playerX, playerY;
+    int32_t gold, elixir;
+    uint32_t waveCount;  // Spawn table rows; the scheduler has no other state
+    int32_t unitCounters[UNIT_KIND_COUNT];
+    uint32_t nextBuildingId;
+    uint32_t nextUnitId;
+    int32_t townhallHealth;
+    uint8_t gameOver;
+    uint8_t hasFlowFields;  // Both fields' searched chunks follow the buildings
+    uint8_t padding[2];
+    uint32_t wallCount, goldMineCount, elixirCollectorCount;
+    uint32_t unitCounts[UNIT_KIND_COUNT];
+};
+
+struct BuildingRecord {
+    int32_t x, y;
+    int32_t health;
+    uint32_t id;
+    uint64_t fillStart;  // Generators only
+    uint16_t icon;
+    uint8_t padding[6];
+};
+
+struct FlowFieldRecord {
+    uint32_t searchLevel;  // FlowField::getSearchLevel()
+    uint32_t chunkCount;   // Chunks the search has entered
+};
+
+struct TargetRecord {
+    uint8_t kind;        // BuildingKind, NONE if the unit is not attacking
+    uint8_t padding[3];
+    int32_t index;       // Dense index in the kind's slot map
+};
+
+static_assert(std::is_trivially_copyable<Position>::value, "positions are copied as bytes");
+static_assert(sizeof(Position) == 8, "snapshot layout assumes 2 x int32 positions");
+static_assert(sizeof(SnapshotHeader) == 120, "snapshot layout changed; bump SNAPSHOT_VERSION");
+static_assert(sizeof(BuildingRecord) == 32, "snapshot layout changed; bump SNAPSHOT_VERSION");
+static_assert(sizeof(FlowFieldRecord) == 8, "snapshot layout changed; bump SNAPSHOT_VERSION");
+static_assert(sizeof(TargetRecord) == 8, "snapshot layout changed; bump SNAPSHOT_VERSION");
+static_assert(std::is_trivially_copyable<WaveSpec>::value, "spawn table rows are copied as bytes");
+static_assert(sizeof(WaveSpec) == 36, "snapshot layout changed; bump SNAPSHOT_VERSION");
+
+// Appends raw bytes, padding to the next 8-byte boundary
+void appendBlock(std::string& out, const void* data, size_t bytes) {
+    out.append(static_cast<const char*>(data), bytes);
+    out.append((8 - out.size() % 8) % 8, '\0');
+}
+
+// Bounds-checked cursor over a mapped snapshot
+struct Reader {
+    const char* data;
+    size_t size;
+    size_t offset;
+
+    // Pointer to the next block of bytes, or nullptr if the file is too short
+    const char* take(size_t bytes) {
+        size_t padded = (bytes + 7) & ~size_t(7);
+        if (padded > size - offset) return nullptr;
+        const char* block = data + offset;
+        offset += padded;
+        return block;
+    }
+
+    // Copies the next n values into a vector
+    template<typename T>
+    bool copyInto(std::vector<T>& values, size_t n) {
+        const char* block = take(n * sizeof(T));
+        if (!block) return false;
+        values.resize(n);
+        if (n > 0) std::memcpy(values.data(), block, n * sizeof(T));
+        return true;
+    }
+};
+
+// Tick a building started filling at; only generators fill
+uint64_t fillStartOf(const Building&) { return 0; }
+uint64_t fillStartOf(const ResourceGenerator& generator) { return generator.getFillStart(); }
+
+template<typename T>
+void appendBuildings(std::string& out, const SlotMap<T>& buildings) {
+    std::vector<BuildingRecord> records(buildings.size());
+    for (size_t i = 0; i < buildings.size(); ++i) {
+        const T& building = buildings[i];
+        BuildingRecord& record = records[i];
+        record.x = building.getPosition().x;
+        record.y = building.getPosition().y;
+        record.health = building.getHealth();
+        record.id = building.getId();
+        record.fillStart = fillStartOf(building);
+        record.icon = static_cast<uint16_t>(building.getIcon());
+    }
+    appendBlock(out, records.data(), records.size() * sizeof(BuildingRecord));
+}
+
+// Appends a flow field's search level and the chunks its search has entered
+void appendFlowField(std::string& out, const FlowField& field) {
+    std::vector<uint32_t> chunkIds;
+    std::vector<uint32_t> distances;
+    field.saveChunks(chunkIds, distances);
+    FlowFieldRecord record{field.getSearchLevel(), static_cast<uint32_t>(chunkIds.size())};
+    appendBlock(out, &record, sizeof(record));
+    appendBlock(out, chunkIds.data(), chunkIds.size() * sizeof(uint32_t));
+    appendBlock(out, distances.data(), distances.size() * sizeof(uint32_t));
+}
+
+// Loads a field written by appendFlowField(); false if it is truncated or invalid
+bool readFlowField(Reader& reader, FlowField& field, const OccupancyGrid& grid, const Building& target) {
+    const char* block = reader.take(sizeof(FlowFieldRecord));
+    if (!block) return false;
+    FlowFieldRecord record;
+    std::memcpy(&record, block, sizeof(record));
+
+    std::vector<uint32_t> chunkIds;
+    std::vector<uint32_t> distances;
+    return reader.copyInto(chunkIds, record.chunkCount) &&
+           reader.copyInto(distances, static_cast<size_t>(record.chunkCount) * CHUNK_CELLS) &&
+           field.restore(grid, target, record.searchLevel, chunkIds, distances);
+}
+
+// Dense index of a target handle in its slot map, -1 if there is none
+int32_t targetIndex(const BuildingStore& buildings, BuildingHandle handle) {
+    switch (handle.kind) {
+        case BuildingKind::WALL: return static_cast<int32_t>(buildings.walls.indexOf(handle.slot));
+        case BuildingKind::GOLD_MINE: return static_cast<int32_t>(buildings.goldMines.indexOf(handle.slot));
+        case BuildingKind::ELIXIR_COLLECTOR:
+            return static_cast<int32_t>(buildings.elixirCollectors.indexOf(handle.slot));
+        default: return -1;
+    }
+}
+
+// Handle of the building at a dense index, none if the index does not resolve
+BuildingHandle targetHandle(const BuildingStore& buildings, BuildingKind kind, int32_t index) {
+    size_t count = 0;
+    switch (kind) {
+        case BuildingKind::TOWNHALL: return buildings.townhallHandle();
+        case BuildingKind::WALL: count = buildings.walls.size(); break;
+        case BuildingKind::GOLD_MINE: count = buildings.goldMines.size(); break;
+        case BuildingKind::ELIXIR_COLLECTOR: count = buildings.elixirCollectors.size(); break;
+        default: return BuildingHandle{};
+    }
+    if (index < 0 || static_cast<size_t>(index) >= count) return BuildingHandle{};
+
+    size_t i = static_cast<size_t>(index);
+    switch (kind) {
+        case BuildingKind::WALL: return BuildingHandle{kind, buildings.walls.handleAt(i)};
+        case BuildingKind::GOLD_MINE: return BuildingHandle{kind, buildings.goldMines.handleAt(i)};
+        default: return BuildingHandle{kind, buildings.elixirCollectors.handleAt(i)};
+    }
+}
+
+// Checks magic, version and header size
+bool validHeader(const char* data, size_t size, std::string* error) {
+    if (size < sizeof(SnapshotHeader) || std::memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        if (error) *error = "not a snapshot file";
+        return false;
+    }
+    SnapshotHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.version != SNAPSHOT_VERSION || header.headerSize != sizeof(SnapshotHeader)) {
+        if (error) *error = "snapshot version " + std::to_string(header.version) +
+                            " is not supported (expected " + std::to_string(SNAPSHOT_VERSION) + ")";
+        return false;
+    }
+    return true;
+}
+
+}
+
+/**
+ * @brief Append the full board state to a snapshot buffer
+ */
+void Board::writeSnapshot(string& out, bool withFlowFields) const {
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.headerSize = sizeof(SnapshotHeader);
+    header.seed = rng.getSeed();
+    header.tick = rng.getTick();
+    header.width = width;
+    header.height = height;
+    header.playerX = player.getPosition().x;
+    header.playerY = player.getPosition().y;
+    header.gold = player.getResources().gold;
+    header.elixir = player.getResources().elixir;
+    header.waveCount = static_cast<uint32_t>(waves.getTable().size());
+    std::memcpy(header.unitCounters, unitCounters, sizeof(unitCounters));
+    header.nextBuildingId = nextBuildingId;
+    header.nextUnitId = units.getNextId();
+    header.townhallHealth = buildings.townhall.getHealth();
+    header.gameOver = gameOver ? 1 : 0;
+    header.hasFlowFields = fieldsBuilt && withFlowFields ? 1 : 0;
+    header.wallCount = static_cast<uint32_t>(buildings.walls.size());
+    header.goldMineCount = static_cast<uint32_t>(buildings.goldMines.size());
+    header.elixirCollectorCount = static_cast<uint32_t>(buildings.elixirCollectors.size());
+    for (int k = 0; k < UNIT_KIND_COUNT; ++k) {
+        header.unitCounts[k] = static_cast<uint32_t>(units.of(static_cast<UnitKind>(k)).size());
+    }
+    appendBlock(out, &header, sizeof(header));
+    appendBlock(out, waves.getTable().data(), waves.getTable().size() * sizeof(WaveSpec));
+
+    appendBuildings(out, buildings.walls);
+    appendBuildings(out, buildings.goldMines);
+    appendBuildings(out, buildings.elixirCollectors);
+    if (header.hasFlowFields) {
+        appendFlowField(out, avoidWallsField);
+        appendFlowField(out, wallCostField);
+    }
+
+    std::vector<TargetRecord> targets;
+    for (int k = 0; k < UNIT_KIND_COUNT; ++k) {
+        const UnitArchetype& archetype = units.of(static_cast<UnitKind>(k));
+        size_t n = archetype.size();
+        appendBlock(out, archetype.id.data(), n * sizeof(uint32_t));
+        appendBlock(out, archetype.position.data(), n * sizeof(Position));
+        appendBlock(out, archetype.health.data(), n * sizeof(int32_t));
+        appendBlock(out, archetype.damage.data(), n * sizeof(int32_t));
+        appendBlock(out, archetype.speedCounter.data(), n * sizeof(int32_t));
+
+        targets.assign(n, TargetRecord{});
+        for (size_t i = 0; i < n; ++i) {
+            targets[i].kind = static_cast<uint8_t>(archetype.target[i].kind);
+            targets[i].index = targetIndex(buildings, archetype.target[i]);
+        }
+        appendBlock(out, targets.data(), n * sizeof(TargetRecord));
+    }
+}
+
+/**
+ * @brief Replace the state of a freshly constructed board with a snapshot
+ */
+bool Board::readSnapshot(const char* data, size_t size) {
+    Reader reader{data, size, 0};
+    const char* block = reader.take(sizeof(SnapshotHeader));
+    if (!block) return false;
+    SnapshotHeader header;
+    std::memcpy(&header, block, sizeof(header));
+    if (header.width != width || header.height != height) return false;
+    if (!isOnMap(Position(header.playerX, header.playerY))) return false;
+
+    rng = Rng(header.seed, header.tick);
+    player.setPosition(header.playerX, header.playerY);
+    player.getResources().gold = header.gold;
+    player.getResources().elixir = header.elixir;
+    std::memcpy(unitCounters, header.unitCounters, sizeof(unitCounters));
+    gameOver = header.gameOver != 0;
+    buildings.townhall.setHealth(header.townhallHealth);
+
+    SpawnTable table;
+    if (!reader.copyInto(table, header.waveCount)) return false;
+    for (const WaveSpec& spec : table) {
+        if (!isValidWave(spec)) return false;
+    }
+    waves.setTable(std::move(table));
+
+    // Buildings keep their ids; the occupancy grid is derived from them. Each
+    // must stand where it could have been built, with a live id below the
+    // next one and not used before. The tick the Town Hall falls leaves that
+    // tick's destroyed buildings in place, so only a lost game may hold them.
+    std::vector<uint32_t> ids{buildings.townhall.getId()};
+    auto isValidBuilding = [&](const Building& building, const BuildingRecord& record) {
+        if (!isOnMap(building) || !CanBuild(&building)) return false;
+        if (record.health <= 0 && !gameOver) return false;
+        if (record.id == 0 || record.id >= header.nextBuildingId) return false;
+        ids.push_back(record.id);
+        return true;
+    };
+    std::vector<BuildingRecord> records;
+    if (!reader.copyInto(records, header.wallCount)) return false;
+    for (const BuildingRecord& record : records) {
+        Wall wall(record.x, record.y);
+        if (!isValidBuilding(wall, record)) return false;
+        wall.setHealth(record.health);
+        wall.setId(record.id);
+        BuildingHandle handle = buildings.add(wall);
+        occupancy.place(*buildings.get(handle), BuildingKind::WALL, handle.slot);
+    }
+    if (!reader.copyInto(records, header.goldMineCount)) return false;
+    for (const BuildingRecord& record : records) {
+        GoldMine mine(record.x, record.y);
+        if (!isValidBuilding(mine, record) || !GlyphTable::isKnown(static_cast<Glyph>(record.icon))) return false;
+        mine.setHealth(record.health);
+        mine.setId(record.id);
+        mine.setIcon(static_cast<Glyph>(record.icon));
+        mine.startFilling(record.fillStart);
+        BuildingHandle handle = buildings.add(mine);
+        occupancy.place(*buildings.get(handle), BuildingKind::GOLD_MINE, handle.slot);
+        scheduleFull(handle);
+    }
+    if (!reader.copyInto(records, header.elixirCollectorCount)) return false;
+    for (const BuildingRecord& record : records) {
+        ElixirCollector collector(record.x, record.y);
+        if (!isValidBuilding(collector, record) || !GlyphTable::isKnown(static_cast<Glyph>(record.icon))) return false;
+        collector.setHealth(record.health);
+        collector.setId(record.id);
+        collector.setIcon(static_cast<Glyph>(record.icon));
+        collector.startFilling(record.fillStart);
+        BuildingHandle handle = buildings.add(collector);
+        occupancy.place(*buildings.get(handle), BuildingKind::ELIXIR_COLLECTOR, handle.slot);
+        scheduleFull(handle);
+    }
+    std::sort(ids.begin(), ids.end());
+    if (std::adjacent_find(ids.begin(), ids.end()) != ids.end()) return false;
+    nextBuildingId = header.nextBuildingId;
+
+    // Saved chunks let the search resume where it stopped; without them the
+    // fields are built on the first tick as usual
+    if (header.hasFlowFields) {
+        if (!readFlowField(reader, avoidWallsField, occupancy, buildings.townhall) ||
+            !readFlowField(reader, wallCostField, occupancy, buildings.townhall)) {
+            return false;
+        }
+        fieldsBuilt = true;
+    }
+
+    std::vector<TargetRecord> targets;
+    for (int k = 0; k < UNIT_KIND_COUNT; ++k) {
+        UnitArchetype& archetype = units.of(static_cast<UnitKind>(k));
+        size_t n = header.unitCounts[k];
+        if (!reader.copyInto(archetype.id, n) || !reader.copyInto(archetype.position, n) ||
+            !reader.copyInto(archetype.health, n) || !reader.copyInto(archetype.damage, n) ||
+            !reader.copyInto(archetype.speedCounter, n) || !reader.copyInto(targets, n)) {
+            return false;
+        }
+        for (const Position& pos : archetype.position) {
+            if (!isOnMap(pos)) return false;
+        }
+        archetype.target.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            archetype.target[i] = targetHandle(buildings, static_cast<BuildingKind>(targets[i].kind), targets[i].index);
+        }
+    }
+    units.setNextId(header.nextUnitId);
+    return true;
+}
+
+/**
+ * @brief Write the full world state to a binary snapshot file
+ *
+ * The snapshot is composed in memory and written with a single write().
+ */
+bool World::save(const std::string& path) const {
+    std::string out;
+    board.writeSnapshot(out);
+
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    size_t written = 0;
+    while (written < out.size()) {
+        ssize_t n = write(fd, out.data() + written, out.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        written += static_cast<size_t>(n);
+    }
+    return close(fd) == 0 && written == out.size();
+}
+
+/**
+ * @brief Create a world from a snapshot file written by save()
+ */
+std::unique_ptr<World> World::load(const std::string& path, int threads, std::string* error) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        if (error) *error = std::strerror(errno);
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        if (error) *error = "empty or unreadable file";
+        close(fd);
+        return nullptr;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        if (error) *error = std::strerror(errno);
+        return nullptr;
+    }
+
+    std::unique_ptr<World> world = fromSnapshot(static_cast<const char*>(mapped), size, threads, error);
+    munmap(mapped, size);
+    return world;
+}
+
+/**
+ * @brief Create a world from snapshot bytes in memory
+ */
+std::unique_ptr<World> World::fromSnapshot(const char* data, size_t size, int threads, std::string* error) {
+    if (!validHeader(data, size, error)) return nullptr;
+    SnapshotHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    std::unique_ptr<World> world(new World(header.seed, threads, MapSize{header.width, header.height}));
+    if (!world->board.readSnapshot(data, size)) {
+        if (error) *error = "truncated or invalid snapshot, or board size mismatch";
+        return nullptr;
+    }
+    return world;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file SpatialHash.cpp
+ * @brief Implementation of the bucketed point index
+ */
+
+#include "SpatialHash.h"
+
+SpatialHash::SpatialHash(int width, int height, int bucketSize)
+    : bucketSize(bucketSize),
+      bucketsX((width + bucketSize - 1) / bucketSize),
+      bucketsY((height + bucketSize - 1) / bucketSize),
+      bucketBegin(static_cast<size_t>(bucketsX) * bucketsY, 0),
+      bucketCount(static_cast<size_t>(bucketsX) * bucketsY, 0) {}
+
+/**
+ * @brief Bucket coordinate of a cell coordinate, clamped to the map
+ */
+int SpatialHash::bucketOf(int coord, int count) const {
+    int b = coord < 0 ? 0 : coord / bucketSize;
+    return b < count ? b : count - 1;
+}
+
+/**
+ * @brief Replace the indexed points
+ *
+ * Counting sort restricted to the buckets in use: the buckets of the
+ * previous rebuild are reset, points are counted per bucket, the used
+ * buckets get consecutive offsets and the indices are scattered. Within a bucket points stay in index order. Buffers are
+ * reused between rebuilds.
+ *
+ * @param positions Positions to index; point i is positions[i]
+ */
+void SpatialHash::rebuild(const std::vector<Position>& positions) {
+    points = positions;
+    for (int b : used) bucketCount[b] = 0;
+    used.clear();
+
+    pointBucket.resize(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        const Position& p = points[i];
+        int b = bucketOf(p.y, bucketsY) * bucketsX + bucketOf(p.x, bucketsX);
+        pointBucket[i] = b;
+        if (bucketCount[b]++ == 0) used.push_back(b);
+    }
+
+    int offset = 0;
+    for (int b : used) {
+        bucketBegin[b] = offset;
+        offset += bucketCount[b];
+    }
+
+    // bucketBegin serves as the write cursor, then is moved back
+    entries.resize(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        entries[bucketBegin[pointBucket[i]]++] = static_cast<int>(i);
+    }
+    for (int b : used) bucketBegin[b] -= bucketCount[b];
+}
@@ -0,0 +1,239 @@
+#include "TerminalRenderer.h"
+#include "Profiler.h"
+#include "UnitTypes.h"
+#include <algorithm>
+#include <cstdio>
+
+using namespace std;
+
+namespace {
+// First left margin row used by the profiler panel, below the game stats
+const int PROFILE_FIRST_ROW = 15;
+
+// Compact value for a fixed-width column: times in us/ms, counters as is
+string formatMetric(Metric metric, uint64_t value) {
+    char text[16];
+    if (!Profiler::isTime(metric)) {
+        snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(value));
+    } else if (value < 1000000) {
+        snprintf(text, sizeof(text), "%.1fus", value / 1e3);
+    } else {
+        snprintf(text, sizeof(text), "%.1fms", value / 1e6);
+    }
+    return text;
+}
+}
+
+TerminalRenderer::TerminalRenderer(int columns, int rows)
+    : frame(columns, rows), columns(columns), rows(rows), viewX(0), viewY(0), playLeft(1),
+      showProfile(false), leftTexts(rows > 2 ? rows - 2 : 0) {}
+
+/* Centers the viewport on the player, keeping it inside the map
+ * A map that fits the screen is shown whole, map cell (x, y) at screen
+ * column x and row y
+ */
+void TerminalRenderer::updateView(const Board& board) {
+    playLeft = board.getMargin() + 1;
+    const Position& pos = board.getPlayer().getPosition();
+    int maxX = max(0, board.getWidth() - columns);
+    int maxY = max(0, board.getHeight() - rows);
+    viewX = min(max(pos.x - (playLeft + columns) / 2, 0), maxX);
+    viewY = min(max(pos.y - rows / 2, 0), maxY);
+}
+
+/* Checks whether any cell of a map rectangle falls inside the play area on screen */
+bool TerminalRenderer::inView(int x, int y, int sizeX, int sizeY) const {
+    int sx = x - viewX, sy = y - viewY;
+    return sx + sizeX > playLeft && sx < columns && sy + sizeY > 1 && sy < rows;
+}
+
+/* Draws a glyph at a map cell if it lies in the play area on screen */
+void TerminalRenderer::putMap(int x, int y, Glyph glyph) {
+    int sx = x - viewX, sy = y - viewY;
+    if (sx < playLeft || sx + GlyphTable::width(glyph) > columns || sy < 1 || sy >= rows) return;
+    frame.put(sx, sy, glyph);
+}
+
+/* Draws text starting at a map cell, clipped to the play area on screen */
+void TerminalRenderer::putMapText(int x, int y, const string& text) {
+    int sx = x - viewX, sy = y - viewY;
+    if (sy < 1 || sy >= rows) return;
+    int first = max(0, playLeft - sx);
+    int last = min(static_cast<int>(text.size()), columns - sx);
+    if (first >= last) return;
+    frame.putText(sx + first, sy, text.substr(first, last - first));
+}
+
+/* Fills the left margin panel with the profiler's last and worst tick
+ * Rows already used by the game stats are left empty
+ */
+void TerminalRenderer::fillProfilePanel() {
+    for (auto& line : leftTexts) line.clear();
+
+    vector<string> lines;
+    if (!Profiler::enabled()) {
+        lines.push_back("Profiling compiled out");
+    } else {
+        char text[64];
+        snprintf(text, sizeof(text), "%-10s %8s %8s", "Profile", "last", "worst");
+        lines.push_back(text);
+        for (int m = 0; m < METRIC_COUNT; ++m) {
+            Metric metric = static_cast<Metric>(m);
+            snprintf(text, sizeof(text), "%-10s %8s %8s", Profiler::name(metric),
+                     formatMetric(metric, Profiler::lastTick(metric)).c_str(),
+                     formatMetric(metric, Profiler::worstTick(metric)).c_str());
+            lines.push_back(text);
+        }
+    }
+
+    // leftTexts[y - 1] is shown on margin row y; keep clear of the status line
+    for (size_t i = 0; i < lines.size(); ++i) {
+        size_t row = PROFILE_FIRST_ROW + i;
+        if (row + 2 >= static_cast<size_t>(rows - 1)) break;
+        leftTexts[row - 1] = lines[i];
+    }
+}
+
+/* Draws a building into the frame
+ * Handles both bordered buildings (walls, mines, collectors) and simple icons
+ */
+void TerminalRenderer::drawBuilding(const Building& building) {
+    int startX = building.getPosition().x;
+    int startY = building.getPosition().y;
+    int sizeX = building.getSizeX();
+    int sizeY = building.getSizeY();
+    Glyph icon = building.getIcon();
+    if (!inView(startX, startY, sizeX, sizeY)) return;
+
+    if (building.Border()) {
+        string edge = "+" + string(sizeX - 2, '-') + "+";
+
+        // Draw top border
+        putMapText(startX, startY, edge);
+
+        // Draw middle rows with icon centered
+        for (int j = 1; j < sizeY - 1; ++j) {
+            putMapText(startX, startY + j, "|" + string(sizeX - 2, ' ') + "|");
+            if (j == sizeY/2) putMap(startX + sizeX/2, startY + j, icon);
+        }
+
+        // Draw bottom border
+        putMapText(startX, startY + sizeY - 1, edge);
+    } else {
+        // Simple icon without border
+        putMap(startX, startY, icon);
+    }
+}
+
+/* Renders the game state visible in the viewport including:
+ * - Borders and UI
+ * - Buildings
+ * - Enemies
+ * - Troops
+ * - Player
+ * - Game over message if applicable
+ * then sends the changes since the previous frame to the terminal
+ */
+void TerminalRenderer::render(const Board& board) {
+    frame.clear();
+    updateView(board);
+    if (showProfile) fillProfilePanel();
+    renderBorder(board, 1);
+    renderMiddle(board);
+    renderBorder(board, rows);
+
+    // Draw the buildings found in the occupancy chunks under the viewport,
+    // each once, from its first visible cell
+    const int left = viewX + playLeft, top = viewY + 1;
+    board.getOccupancy().forEachOccupiedIn(left, top, viewX + columns - 1, viewY + rows - 1,
+                                           [&](int x, int y, const Occupant& cell) {
+        const Building* building = board.getBuildings().get(cell);
+        if (!building) return;
+        const Position& pos = building->getPosition();
+        if (x == max(pos.x, left) && y == max(pos.y, top)) drawBuilding(*building);
+    });
+
+    // Draw enemies, then troops
+    auto drawUnits = [&](auto kind) {
+        Glyph icon = unitStats(kind).icon;
+        for (const auto& pos : board.getUnits().of(kind).position) {
+            putMap(pos.x, pos.y, icon);
+        }
+    };
+    forEachKind(EnemyKinds(), drawUnits);
+    forEachKind(TroopKinds(), drawUnits);
+
+    // Draw player
+    const Player& player = board.getPlayer();
+    putMap(player.getPosition().x, player.getPosition().y, player.getIcon());
+
+    // Game over banner; the caller decides when to quit
+    if (board.isGameOver()) {
+        string message = "GAME OVER - Town Hall Destroyed!";
+        frame.putText((columns - message.length())/2, rows/2, message);
+    }
+
+    frame.present(1, rows + 1);
+}
+
+/* Renders a top or bottom border row with margin separator */
+void TerminalRenderer::renderBorder(const Board& board, int row) {
+    string line(columns, '-');
+    line.front() = '+';
+    line.back() = '+';
+    line[board.getMargin()] = '+';
+    frame.putText(1, row, line);
+}
+
+/* Renders the middle section of the game UI including:
+ * - Resource counts
+ * - Building counts
+ * - Townhall health
+ * - Enemy count, then the units of each enemy kind spawned
+ * - Troop count, then the units of each troop kind trained
+ * - Map size and player position
+ * - Profiler panel, when shown
+ * - Last status message
+ */
+void TerminalRenderer::renderMiddle(const Board& board) {
+    const int margin = board.getMargin();
+    const Player& player = board.getPlayer();
+
+    // Game stats shown from the first margin row down; empty lines are gaps
+    vector<string> stats = {
+        "Gold = " + to_string(player.getResources().gold),
+        "Elixir = " + to_string(player.getResources().elixir),
+        "Walls = " + to_string(board.getWalls().size()) + "/200",
+        "Gold Mines = " + to_string(board.getGoldMines().size()) + "/3",
+        "Elixir Generators = " + to_string(board.getElixirCollectors().size()) + "/3",
+        "Town Hall HP = " + to_string(board.getTownHall().getHealth()),
+    };
+    auto addCounter = [&](auto kind) {
+        stats.push_back(string(unitStats(kind).plural) + " = " + to_string(board.getUnitCounter(kind)));
+    };
+    stats.push_back("Enemies = " + to_string(board.getUnits().enemyCount()));
+    forEachKind(EnemyKinds(), addCounter);
+    stats.push_back("");
+    stats.push_back("Troops = " + to_string(board.getUnits().troopCount()));
+    forEachKind(TroopKinds(), addCounter);
+    stats.push_back("Map " + to_string(board.getWidth()) + "x" + to_string(board.getHeight()) + " @ " +
+                    to_string(player.getPosition().x) + "," + to_string(player.getPosition().y));
+
+    for (int y = 1; y < rows - 1; y++) {
+        // Display various game stats in the left margin
+        string line;
+        if (y <= static_cast<int>(stats.size()) && !stats[y - 1].empty()) {
+            line = stats[y - 1];
+        } else if (y == rows - 2) {
+            line = board.getStatusMessage();
+        } else if (showProfile) {
+            line = leftTexts[y - 1];
+        }
+        if (line.length() > static_cast<size_t>(margin - 1)) line.resize(margin - 1);
+
+        // Screen row y + 1, below the top border; the frame starts out blank
+        frame.putText(1, y + 1, "|" + line);
+        frame.putText(margin + 1, y + 1, "|");
+        frame.putText(columns, y + 1, "|");
+    }
+}
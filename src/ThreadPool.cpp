@@ -0,0 +1,83 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief Implementation of the worker pool used by the parallel tick
+ */
+
+#include "ThreadPool.h"
+
+/**
+ * @brief Start a pool
+ *
+ * @param workers Total number of workers including the calling thread;
+ *        0 uses the hardware concurrency
+ */
+ThreadPool::ThreadPool(int workers)
+    : invoke(nullptr), body(nullptr), count(0), grain(1), next(0),
+      busy(0), generation(0), stopping(false) {
+    if (workers <= 0) workers = std::max(1u, std::thread::hardware_concurrency());
+    for (int w = 1; w < workers; ++w) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, w);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& thread : threads) thread.join();
+}
+
+/**
+ * @brief Claim and run chunks of the current job until none are left
+ */
+void ThreadPool::runChunks(int worker) {
+    for (;;) {
+        size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+        if (begin >= count) return;
+        invoke(body, begin, std::min(begin + grain, count), worker);
+    }
+}
+
+/**
+ * @brief Body of each pool thread: wait for a job, help run it, report back
+ */
+void ThreadPool::workerLoop(int worker) {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+
+        runChunks(worker);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busy == 0) finished.notify_one();
+    }
+}
+
+/**
+ * @brief Publish a job, run chunks on the calling thread too, then wait
+ */
+void ThreadPool::run(size_t n, size_t chunk, Invoke fn, void* ctx) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        invoke = fn;
+        body = ctx;
+        count = n;
+        grain = chunk;
+        next.store(0, std::memory_order_relaxed);
+        busy = static_cast<int>(threads.size());
+        ++generation;
+    }
+    wake.notify_all();
+
+    runChunks(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&] { return busy == 0; });
+}
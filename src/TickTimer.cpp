@@ -0,0 +1,65 @@
+/**
+ * @file TickTimer.cpp
+ * @brief timerfd-backed periodic tick source with a clock fallback
+ */
+
+#include "TickTimer.h"
+#include <cerrno>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/timerfd.h>
+#endif
+
+TickTimer::TickTimer(int periodMs)
+    : timerFd(-1), period(std::chrono::milliseconds(periodMs)), nextTick(Clock::now() + period) {
+#ifdef __linux__
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerFd >= 0) {
+        itimerspec spec{};
+        spec.it_interval.tv_sec = periodMs / 1000;
+        spec.it_interval.tv_nsec = static_cast<long>(periodMs % 1000) * 1000000L;
+        spec.it_value = spec.it_interval;
+        if (timerfd_settime(timerFd, 0, &spec, nullptr) != 0) {
+            close(timerFd);
+            timerFd = -1;
+        }
+    }
+#endif
+}
+
+TickTimer::~TickTimer() {
+    if (timerFd >= 0) close(timerFd);
+}
+
+/**
+ * @brief Milliseconds until the next tick is due (0 if one is due now)
+ */
+int TickTimer::msUntilDue() const {
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(nextTick - Clock::now()).count();
+    return left > 0 ? static_cast<int>(left) : 0;
+}
+
+/**
+ * @brief Number of ticks that came due since the last call
+ *
+ * With a timerfd this reads its expiration counter, which never blocks;
+ * otherwise it counts the periods elapsed on the steady clock.
+ */
+uint64_t TickTimer::takeDue() {
+    if (timerFd >= 0) {
+        uint64_t expirations = 0;
+        ssize_t n;
+        do {
+            n = read(timerFd, &expirations, sizeof(expirations));
+        } while (n < 0 && errno == EINTR);
+        return n == static_cast<ssize_t>(sizeof(expirations)) ? expirations : 0;
+    }
+
+    uint64_t due = 0;
+    Clock::time_point now = Clock::now();
+    while (nextTick <= now) {
+        nextTick += period;
+        ++due;
+    }
+    return due;
+}
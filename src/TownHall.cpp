@@ -1,3 +1,3 @@
 #include "TownHall.h"
 
-TownHall::TownHall(int x, int y) : Building(x, y, 9, 5, 0, 0, 500, 1, "🏰") {}
+TownHall::TownHall(int x, int y) : Building(x, y, 9, 5, 0, 0, 500, 1, Glyph::TOWNHALL) {}
@@ -0,0 +1,105 @@
+/**
+ * @file TroopSystem.cpp
+ * @brief Per-tick behavior of troop archetypes
+ */
+
+#include "TroopSystem.h"
+#include "UnitTypes.h"
+#include <algorithm>
+
+namespace {
+// Troops per parallel work item; troop queries cost more than enemy moves
+const size_t TROOP_CHUNK = 128;
+
+/**
+ * @brief Troop update of one kind; range and damage rules are compile-time constants
+ */
+template<UnitKind K>
+void updateTroops(UnitArchetype& troops, EnemyView& enemies, std::vector<int>& targets, ThreadPool& pool,
+                  std::vector<TroopScratch>& scratch) {
+    constexpr UnitStats stats = UnitType<K>::stats;
+    const std::vector<int>& enemyHealth = enemies.health;
+    auto isAlive = [&](int i) { return enemyHealth[i] > 0; };
+
+    scratch.resize(pool.size());
+    targets.resize(troops.size());
+
+    // Decide phase: enemies are only read; each troop moves itself and
+    // records the enemy it attacks
+    pool.parallelFor(troops.size(), TROOP_CHUNK, [&](size_t begin, size_t end, int worker) {
+        TroopScratch& local = scratch[worker];
+        for (size_t t = begin; t < end; ++t) {
+            targets[t] = -1;
+            if (troops.health[t] <= 0) continue;
+            Position troopPos = troops.position[t];
+
+            // Try to attack the closest enemy within range (only one per update)
+            int target = enemies.index.nearestWithin(troopPos, stats.range, isAlive);
+            if (target >= 0) {
+                targets[t] = target;
+                continue;
+            }
+
+            // Otherwise step toward the nearest enemy, around buildings
+            if (enemies.field.reached(troopPos)) {
+                troops.position[t] = enemies.field.nextStep(troopPos);
+                continue;
+            }
+
+            // Beyond the field's search: head straight for the nearest enemy
+            enemies.index.kNearest(troopPos, 1, isAlive, local.nearest);
+            if (local.nearest.empty()) continue;
+            troops.position[t] = enemies.field.straightStep(troopPos, enemies.positions[local.nearest.front().second]);
+        }
+    });
+
+    // Apply phase: each troop's damage, applied in troop order to enemy health
+    for (size_t t = 0; t < troops.size(); ++t) {
+        if (targets[t] >= 0) enemies.health[targets[t]] -= troops.damage[t];
+    }
+}
+
+}
+
+/**
+ * @brief Copy the enemies' positions and health, rebuild the index and the field
+ */
+void EnemyView::gather(const UnitStore& units, const OccupancyGrid& grid) {
+    positions.clear();
+    health.clear();
+    forEachKind(EnemyKinds(), [&](auto kind) {
+        const UnitArchetype& archetype = units.of(kind);
+        positions.insert(positions.end(), archetype.position.begin(), archetype.position.end());
+        health.insert(health.end(), archetype.health.begin(), archetype.health.end());
+    });
+    index.rebuild(positions);
+
+    troopPositions.clear();
+    forEachKind(TroopKinds(), [&](auto kind) {
+        const UnitArchetype& archetype = units.of(kind);
+        troopPositions.insert(troopPositions.end(), archetype.position.begin(), archetype.position.end());
+    });
+    field.build(positions, troopPositions, grid);
+}
+
+/**
+ * @brief Write the health back to the enemy archetypes
+ */
+void EnemyView::scatter(UnitStore& units) const {
+    auto from = health.begin();
+    forEachKind(EnemyKinds(), [&](auto kind) {
+        UnitArchetype& archetype = units.of(kind);
+        std::copy(from, from + static_cast<long>(archetype.size()), archetype.health.begin());
+        from += static_cast<long>(archetype.size());
+    });
+}
+
+/**
+ * @brief Updates every troop of one archetype for a tick
+ */
+void updateTroopArchetype(UnitArchetype& troops, EnemyView& enemies, std::vector<int>& targets, ThreadPool& pool,
+                          std::vector<TroopScratch>& scratch) {
+    forEachKind(TroopKinds(), [&](auto kind) {
+        if (troops.kind == kind) updateTroops<decltype(kind)::value>(troops, enemies, targets, pool, scratch);
+    });
+}
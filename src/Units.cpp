@@ -0,0 +1,146 @@
+/**
+ * @file Units.cpp
+ * @brief Component storage for enemies and troops
+ */
+
+#include "Units.h"
+#include "UnitTypes.h"
+#include "Profiler.h"
+#include <algorithm>
+
+/**
+ * @brief Stats of a unit kind
+ */
+const UnitStats& unitStats(UnitKind kind) {
+    return UNIT_TYPES[static_cast<int>(kind)];
+}
+
+UnitArchetype::UnitArchetype(UnitKind kind) : kind(kind) {}
+
+/**
+ * @brief Append a unit with the kind's starting stats
+ */
+void UnitArchetype::add(uint32_t unitId, const Position& pos) {
+    const UnitStats& stats = unitStats(kind);
+    if (size() == capacity()) PROFILE_COUNT(Metric::POOL_GROWTHS, 1);
+    id.push_back(unitId);
+    position.push_back(pos);
+    health.push_back(stats.health);
+    damage.push_back(stats.damage);
+    speedCounter.push_back(0);
+    target.push_back(BuildingHandle{});
+}
+
+/**
+ * @brief Append n units with the kind's starting stats in one operation
+ */
+void UnitArchetype::addBatch(uint32_t firstId, const std::vector<uint32_t>& order,
+                             const std::vector<Position>& positions) {
+    size_t n = positions.size();
+    if (n == 0) return;
+    if (size() + n > capacity()) {
+        reserve(std::max(size() + n, 2 * capacity()));
+        PROFILE_COUNT(Metric::POOL_GROWTHS, 1);
+    }
+
+    const UnitStats& stats = unitStats(kind);
+    size_t first = size();
+    id.resize(first + n);
+    for (size_t i = 0; i < n; ++i) id[first + i] = firstId + order[i];
+    position.insert(position.end(), positions.begin(), positions.end());
+    health.insert(health.end(), n, stats.health);
+    damage.insert(damage.end(), n, stats.damage);
+    speedCounter.insert(speedCounter.end(), n, 0);
+    target.insert(target.end(), n, BuildingHandle{});
+}
+
+/**
+ * @brief Preallocate room for n units
+ */
+void UnitArchetype::reserve(size_t n) {
+    id.reserve(n);
+    position.reserve(n);
+    health.reserve(n);
+    damage.reserve(n);
+    speedCounter.reserve(n);
+    target.reserve(n);
+}
+
+/**
+ * @brief Remove every unit with health <= 0 in one order-preserving pass
+ *
+ * @return Number of units removed
+ */
+size_t UnitArchetype::removeDead() {
+    size_t kept = 0;
+    for (size_t i = 0; i < size(); ++i) {
+        if (health[i] <= 0) continue;
+        if (kept != i) {
+            id[kept] = id[i];
+            position[kept] = position[i];
+            health[kept] = health[i];
+            damage[kept] = damage[i];
+            speedCounter[kept] = speedCounter[i];
+            target[kept] = target[i];
+        }
+        ++kept;
+    }
+
+    size_t removed = size() - kept;
+    if (removed > 0) {
+        id.resize(kept);
+        position.resize(kept);
+        health.resize(kept);
+        damage.resize(kept);
+        speedCounter.resize(kept);
+        target.resize(kept);
+    }
+    return removed;
+}
+
+UnitStore::UnitStore() : nextId(1) {
+    for (int k = 0; k < UNIT_KIND_COUNT; ++k) {
+        archetypes.emplace_back(static_cast<UnitKind>(k));
+    }
+}
+
+/**
+ * @brief Create a unit of the given kind
+ *
+ * @return Id of the new unit
+ */
+uint32_t UnitStore::spawn(UnitKind kind, const Position& pos) {
+    uint32_t unitId = nextId++;
+    of(kind).add(unitId, pos);
+    return unitId;
+}
+
+/**
+ * @brief Claim n consecutive unit ids for a batch
+ *
+ * @return The first id
+ */
+uint32_t UnitStore::takeIds(uint32_t n) {
+    uint32_t first = nextId;
+    nextId += n;
+    return first;
+}
+
+/**
+ * @brief Preallocate room for n units of every kind
+ */
+void UnitStore::reserve(size_t n) {
+    for (auto& archetype : archetypes) archetype.reserve(n);
+}
+
+size_t UnitStore::enemyCount() const {
+    size_t count = 0;
+    forEachKind(EnemyKinds(), [&](auto kind) { count += of(kind).size(); });
+    return count;
+}
+
+size_t UnitStore::troopCount() const {
+    size_t count = 0;
+    forEachKind(TroopKinds(), [&](auto kind) { count += of(kind).size(); });
+    return count;
+}
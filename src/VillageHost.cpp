@@ -0,0 +1,279 @@
+/**
+ * @file VillageHost.cpp
+ * @brief Work-stealing scheduler for many independent worlds
+ */
+
+#include "VillageHost.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// Sleeping for less than this costs more than it saves; yield instead
+const uint64_t MIN_SLEEP_NS = 20000;
+// An idle worker looks for villages to steal at least this often
+const uint64_t MAX_IDLE_NS = 200000;
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+int latencyBucket(uint64_t ns) {
+    if (ns < LATENCY_SUB_BUCKETS) return static_cast<int>(ns);
+    int msb = 63 - __builtin_clzll(ns);
+    int shift = msb - 3;
+    return (msb - 2) * LATENCY_SUB_BUCKETS + static_cast<int>((ns >> shift) & (LATENCY_SUB_BUCKETS - 1));
+}
+
+// First duration past the end of a bucket
+uint64_t bucketEnd(int bucket) {
+    if (bucket < LATENCY_SUB_BUCKETS) return static_cast<uint64_t>(bucket) + 1;
+    int msb = bucket / LATENCY_SUB_BUCKETS + 2;
+    uint64_t sub = static_cast<uint64_t>(bucket % LATENCY_SUB_BUCKETS);
+    return (LATENCY_SUB_BUCKETS + sub + 1) << (msb - 3);
+}
+
+// CPUs the process may run on, in order
+std::vector<int> allowedCpus() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+    }
+#endif
+    return cpus;
+}
+
+bool pinCurrentThread(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+using Deadline = std::pair<uint64_t, uint32_t>;
+using EarliestFirst = std::greater<Deadline>;
+
+}
+
+void VillageStats::record(uint64_t ns, uint64_t lag) {
+    ++ticks;
+    tickNs += ns;
+    maxTickNs = std::max(maxTickNs, ns);
+    lagNs += lag;
+    maxLagNs = std::max(maxLagNs, lag);
+    ++histogram[latencyBucket(ns)];
+}
+
+void VillageStats::merge(const VillageStats& other) {
+    ticks += other.ticks;
+    tickNs += other.tickNs;
+    maxTickNs = std::max(maxTickNs, other.maxTickNs);
+    lagNs += other.lagNs;
+    maxLagNs = std::max(maxLagNs, other.maxLagNs);
+    for (int b = 0; b < LATENCY_BUCKETS; ++b) histogram[b] += other.histogram[b];
+}
+
+/**
+ * @brief Tick duration below which a fraction p of the ticks fall
+ */
+uint64_t VillageStats::percentileNs(double p) const {
+    if (ticks == 0) return 0;
+    uint64_t wanted = static_cast<uint64_t>(p * static_cast<double>(ticks) + 0.5);
+    wanted = std::min(std::max<uint64_t>(wanted, 1), ticks);
+    uint64_t seen = 0;
+    for (int b = 0; b < LATENCY_BUCKETS; ++b) {
+        seen += histogram[b];
+        if (seen >= wanted) return std::min(bucketEnd(b), maxTickNs);
+    }
+    return maxTickNs;
+}
+
+VillageHost::VillageHost(HostOptions options) : options(options) {
+    int threads = options.threads > 0 ? options.threads
+                                      : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int w = 0; w < threads; ++w) workers.emplace_back(new Worker());
+}
+
+/**
+ * @brief Add a village; only between runs
+ */
+size_t VillageHost::addVillage(const VillageConfig& config) {
+    Village village;
+    village.world.reset(new World(config.seed, 1, config.size, config.waves));
+    village.world->getBoard().setProfilerTicks(false);
+    village.intervalNs = static_cast<uint64_t>(config.tickMicros) * 1000;
+    village.dueNs = 0;
+    village.tickLimit = 0;
+    villages.push_back(std::move(village));
+    return villages.size() - 1;
+}
+
+/**
+ * @brief Run every village until it has done ticksPerVillage more ticks,
+ *        its game is over, or seconds have passed
+ */
+HostReport VillageHost::run(uint64_t ticksPerVillage, double seconds) {
+    HostReport report;
+    report.threads = threadCount();
+    if (villages.empty() || (ticksPerVillage == 0 && seconds <= 0)) return report;
+
+    for (auto& worker : workers) {
+        worker->ready.clear();
+        worker->timers.clear();
+        worker->steals = 0;
+    }
+
+    // Cadenced villages start at staggered offsets so their ticks do not all fall due together
+    uint64_t start = nowNs();
+    size_t active = 0;
+    for (size_t i = 0; i < villages.size(); ++i) {
+        Village& village = villages[i];
+        village.stats = VillageStats();
+        village.tickLimit = ticksPerVillage > 0 ? ticksPerVillage : UINT64_MAX;
+        if (village.world->isGameOver()) continue;
+
+        Worker& owner = *workers[i % workers.size()];
+        village.dueNs = start + village.intervalNs * i / villages.size();
+        if (village.intervalNs == 0) {
+            owner.ready.push_back(static_cast<uint32_t>(i));
+        } else {
+            owner.timers.emplace_back(village.dueNs, static_cast<uint32_t>(i));
+            std::push_heap(owner.timers.begin(), owner.timers.end(), EarliestFirst());
+        }
+        ++active;
+    }
+    remaining.store(active);
+    stopping.store(false);
+    stopNs = seconds > 0 ? start + static_cast<uint64_t>(seconds * 1e9) : 0;
+
+    std::vector<int> cpus = options.pinThreads ? allowedCpus() : std::vector<int>();
+    std::atomic<int> pinned(0);
+    std::vector<std::thread> threads;
+    for (int w = 0; w < threadCount(); ++w) {
+        threads.emplace_back([this, w, &cpus, &pinned] {
+            if (!cpus.empty() && pinCurrentThread(cpus[w % cpus.size()])) ++pinned;
+            workerLoop(w);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    report.seconds = static_cast<double>(nowNs() - start) / 1e9;
+    report.pinned = pinned.load();
+    for (const auto& worker : workers) report.steals += worker->steals;
+    for (const Village& village : villages) report.all.merge(village.stats);
+    report.villageTicks = report.all.ticks;
+    report.villageTicksPerSecond = report.seconds > 0 ? static_cast<double>(report.villageTicks) / report.seconds : 0;
+    return report;
+}
+
+/**
+ * @brief Body of each host thread: release due villages, run ready ones, steal when idle
+ */
+void VillageHost::workerLoop(int index) {
+    Worker& self = *workers[index];
+    uint32_t village;
+    while (!stopping.load(std::memory_order_relaxed)) {
+        uint64_t now = nowNs();
+        if (stopNs > 0 && now >= stopNs) {
+            stopping.store(true, std::memory_order_relaxed);
+            break;
+        }
+
+        if (!self.timers.empty() && self.timers.front().first <= now) {
+            std::lock_guard<std::mutex> lock(self.mutex);
+            while (!self.timers.empty() && self.timers.front().first <= now) {
+                std::pop_heap(self.timers.begin(), self.timers.end(), EarliestFirst());
+                self.ready.push_back(self.timers.back().second);
+                self.timers.pop_back();
+            }
+        }
+
+        if (takeReady(index, village)) {
+            runTick(index, village);
+            continue;
+        }
+        if (remaining.load(std::memory_order_acquire) == 0) break;
+
+        // Nothing runnable: wait for the next own deadline, waking now and
+        // then to look for work on other workers
+        uint64_t wait = MAX_IDLE_NS;
+        if (!self.timers.empty()) wait = std::min(wait, self.timers.front().first - now);
+        if (stopNs > 0) wait = std::min(wait, stopNs - now);
+        if (wait >= MIN_SLEEP_NS) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(wait));
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/**
+ * @brief Next village to tick: the oldest of the own queue, else the newest of another worker's
+ */
+bool VillageHost::takeReady(int index, uint32_t& village) {
+    Worker& self = *workers[index];
+    {
+        std::lock_guard<std::mutex> lock(self.mutex);
+        if (!self.ready.empty()) {
+            village = self.ready.front();
+            self.ready.pop_front();
+            return true;
+        }
+    }
+
+    int count = threadCount();
+    for (int offset = 1; offset < count; ++offset) {
+        Worker& victim = *workers[(index + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.ready.empty()) {
+            village = victim.ready.back();
+            victim.ready.pop_back();
+            ++self.steals;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Step one village by a tick and requeue it on this worker
+ */
+void VillageHost::runTick(int index, uint32_t id) {
+    Worker& self = *workers[index];
+    Village& village = villages[id];
+
+    uint64_t start = nowNs();
+    uint64_t lag = village.intervalNs > 0 && start > village.dueNs ? start - village.dueNs : 0;
+    village.world->step(1);
+    village.stats.record(nowNs() - start, lag);
+
+    if (--village.tickLimit == 0 || village.world->isGameOver()) {
+        remaining.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+    if (village.intervalNs == 0) {
+        std::lock_guard<std::mutex> lock(self.mutex);
+        self.ready.push_back(id);
+    } else {
+        village.dueNs += village.intervalNs;
+        self.timers.emplace_back(village.dueNs, id);
+        std::push_heap(self.timers.begin(), self.timers.end(), EarliestFirst());
+    }
+}
@@ -1,3 +1,3 @@
 #include "Wall.h"
 
-Wall::Wall(int x, int y) : Building(x, y, 1, 1, 10, 0, 100, 200, "🧱", false) {}
+Wall::Wall(int x, int y) : Building(x, y, 1, 1, 10, 0, 100, 200, Glyph::WALL, false) {}
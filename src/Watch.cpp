@@ -0,0 +1,196 @@
+/**
+ * @file Watch.cpp
+ * @brief Terminal observer: draws a game published with VILLAGE_OBSERVE
+ *
+ *   village_watch <socket>
+ *
+ * Connects to the game's observer socket, rebuilds the board from each
+ * keyframe, applies the deltas in between and draws it with the game's
+ * own TerminalRenderer. Q quits; the game itself is not affected.
+ */
+
+#include "World.h"
+#include "ObserverStream.h"
+#include "TerminalRenderer.h"
+#include "InputManager.h"
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+using namespace std;
+
+namespace {
+
+// Minimum time between two frames; deltas in between are batched
+const chrono::milliseconds FRAME_INTERVAL(16);
+
+// Bytes read from the socket per read()
+const size_t READ_CHUNK = 1 << 16;
+
+// Screen size for the viewport, as in the game
+void screenSize(const Board& board, int& columns, int& rows) {
+    columns = board.getWidth();
+    rows = board.getHeight();
+    winsize ws{};
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) != 0 || ws.ws_col == 0 || ws.ws_row == 0) return;
+    columns = min(columns, max<int>(ws.ws_col, board.getMargin() + 20));
+    rows = min(rows, max<int>(ws.ws_row - 1, MapSize::MIN_HEIGHT));
+}
+
+int connectTo(const char* path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    strcpy(address.sun_path, path);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Observer state rebuilt from the stream
+ */
+struct Observer {
+    unique_ptr<World> world;
+    unique_ptr<TerminalRenderer> renderer;
+    ObservedDelta delta;
+    string status;
+    string error;
+
+    // Applies one message; false if the stream is unusable
+    bool apply(const StreamHeader& header, const char* payload) {
+        if (header.version != OBSERVER_STREAM_VERSION) {
+            error = "observer stream version " + to_string(header.version) + " is not supported";
+            return false;
+        }
+        if (header.type == static_cast<uint16_t>(StreamMessage::KEYFRAME)) {
+            const char* snapshot;
+            size_t snapshotBytes;
+            if (!decodeKeyframe(payload, header.bytes, status, snapshot, snapshotBytes)) {
+                error = "damaged keyframe";
+                return false;
+            }
+            world = World::fromSnapshot(snapshot, snapshotBytes, 1, &error);
+            if (!world) return false;
+            world->getBoard().setStatusMessage(status);
+            if (!renderer) {
+                int columns, rows;
+                screenSize(world->getBoard(), columns, rows);
+                renderer.reset(new TerminalRenderer(columns, rows));
+            }
+        } else if (header.type == static_cast<uint16_t>(StreamMessage::DELTA) && world) {
+            if (!decodeDelta(header.tick, payload, header.bytes, delta)) {
+                error = "damaged delta";
+                return false;
+            }
+            if (!world->getBoard().applyObservedDelta(delta)) {
+                error = "delta does not fit the board";
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        cerr << "usage: " << argv[0] << " <socket>" << endl;
+        return 2;
+    }
+    int socketFd = connectTo(argv[1]);
+    if (socketFd < 0) {
+        cerr << argv[1] << ": " << strerror(errno) << endl;
+        return 1;
+    }
+
+    cout << "\033[?25l" << flush;
+    InputManager inputManager;
+    Observer observer;
+    vector<char> inbox;   // Received bytes not yet applied, starting at a message boundary
+    bool quit = false;
+    bool ended = false;
+    bool dirty = false;
+    auto nextFrame = chrono::steady_clock::now();
+    while (!quit && !ended) {
+        auto now = chrono::steady_clock::now();
+        if (dirty && observer.renderer && now >= nextFrame) {
+            observer.renderer->render(observer.world->getBoard());
+            dirty = false;
+            nextFrame = now + FRAME_INTERVAL;
+        }
+
+        pollfd fds[2] = {
+            { inputManager.fd(), POLLIN, 0 },
+            { socketFd, POLLIN, 0 },
+        };
+        int timeout = -1;
+        if (dirty) {
+            timeout = static_cast<int>(chrono::duration_cast<chrono::milliseconds>(nextFrame - now).count());
+            if (timeout < 0) timeout = 0;
+        }
+        if (poll(fds, 2, timeout) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        if (fds[0].revents & (POLLIN | POLLHUP | POLLERR)) {
+            vector<char> commands;
+            if (!inputManager.readCommands(commands)) quit = true;
+            if (find(commands.begin(), commands.end(), 'Q') != commands.end()) quit = true;
+        }
+
+        if (fds[1].revents & (POLLIN | POLLHUP | POLLERR)) {
+            size_t used = inbox.size();
+            inbox.resize(used + READ_CHUNK);
+            ssize_t n = read(socketFd, inbox.data() + used, READ_CHUNK);
+            if (n < 0 && errno == EINTR) n = 0;
+            if (n <= 0) {
+                inbox.resize(used);
+                ended = true;
+            } else {
+                inbox.resize(used + static_cast<size_t>(n));
+            }
+
+            // Apply every complete message; a partial one waits for more bytes
+            size_t offset = 0;
+            StreamHeader header;
+            while (inbox.size() - offset >= sizeof(header)) {
+                memcpy(&header, inbox.data() + offset, sizeof(header));
+                if (inbox.size() - offset - sizeof(header) < header.bytes) break;
+                if (!observer.apply(header, inbox.data() + offset + sizeof(header))) {
+                    ended = true;
+                    break;
+                }
+                offset += sizeof(header) + header.bytes;
+                dirty = true;
+            }
+            inbox.erase(inbox.begin(), inbox.begin() + static_cast<long>(offset));
+        }
+    }
+    if (dirty && observer.renderer) observer.renderer->render(observer.world->getBoard());
+    cout << "\033[?25h" << flush;
+    close(socketFd);
+
+    if (!observer.error.empty()) {
+        cerr << "village_watch: " << observer.error << endl;
+        return 1;
+    }
+    if (ended && !quit) cerr << "village_watch: the game closed the stream" << endl;
+    return 0;
+}
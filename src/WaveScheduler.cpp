@@ -0,0 +1,358 @@
+/**
+ * @file WaveScheduler.cpp
+ * @brief Spawn tables, their text format, and wave generation
+ */
+
+#include "WaveScheduler.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+const char* const RAMP_NAMES[] = { "constant", "linear", "exp" };
+const char* const SHAPE_NAMES[] = { "blob", "line", "column" };
+const int RAMP_COUNT = 3;
+const int SHAPE_COUNT = 3;
+const char EDGE_LETTERS[] = "trbl";  // Bit i of the edge mask
+
+// Index of name in names, or -1
+int indexOf(const char* const* names, int count, const std::string& name) {
+    for (int i = 0; i < count; ++i) {
+        if (name == names[i]) return i;
+    }
+    return -1;
+}
+
+// Name of an enum value, or "?" for a value past the end of names
+const char* nameOf(const char* const* names, int count, int value) {
+    return value >= 0 && value < count ? names[value] : "?";
+}
+
+// Parses an unsigned decimal no larger than max
+bool parseNumber(const std::string& text, uint32_t max, uint32_t& value) {
+    if (text.empty() || text[0] < '0' || text[0] > '9') return false;
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long parsed = strtoull(text.c_str(), &end, 10);
+    if (errno != 0 || *end != '\0' || parsed > max) return false;
+    value = static_cast<uint32_t>(parsed);
+    return true;
+}
+
+bool parseByte(const std::string& text, uint32_t max, uint8_t& value) {
+    uint32_t parsed;
+    if (!parseNumber(text, max, parsed)) return false;
+    value = static_cast<uint8_t>(parsed);
+    return true;
+}
+
+// Sets one key=value field of a row; false if the key or value is invalid
+bool parseField(const std::string& key, const std::string& value, WaveSpec& spec) {
+    const uint32_t ANY = UINT32_MAX;
+    if (key == "start") return parseNumber(value, ANY, spec.start);
+    if (key == "every") return parseNumber(value, ANY, spec.every);
+    if (key == "waves") return parseNumber(value, ANY, spec.waves);
+    if (key == "groups") return parseNumber(value, ANY, spec.groups);
+    if (key == "step") return parseNumber(value, ANY, spec.rampStep);
+    if (key == "max") return parseNumber(value, MAX_WAVE_GROUPS, spec.maxGroups);
+    if (key == "raiders") return parseByte(value, 100, spec.raiderPercent);
+    if (key == "follow") return parseByte(value, 100, spec.followPercent);
+    if (key == "same") return parseByte(value, 100, spec.sameKindPercent);
+    if (key == "spread") return parseByte(value, 255, spec.spread);
+    if (key == "ramp") {
+        int ramp = indexOf(RAMP_NAMES, RAMP_COUNT, value);
+        if (ramp < 0) return false;
+        spec.ramp = static_cast<RampCurve>(ramp);
+        return true;
+    }
+    if (key == "shape") {
+        int shape = indexOf(SHAPE_NAMES, SHAPE_COUNT, value);
+        if (shape < 0) return false;
+        spec.shape = static_cast<ClusterShape>(shape);
+        return true;
+    }
+    if (key == "edges") {
+        uint8_t edges = 0;
+        for (char letter : value) {
+            const char* found = strchr(EDGE_LETTERS, letter);
+            if (!found || letter == '\0') return false;
+            edges |= static_cast<uint8_t>(1 << (found - EDGE_LETTERS));
+        }
+        if (edges == 0) return false;
+        spec.edges = edges;
+        return true;
+    }
+    if (key == "followers") {
+        size_t dash = value.find('-');
+        std::string low = value.substr(0, dash);
+        std::string high = dash == std::string::npos ? low : value.substr(dash + 1);
+        return parseByte(low, 255, spec.followersMin) && parseByte(high, 255, spec.followersMax) &&
+               spec.followersMin <= spec.followersMax;
+    }
+    return false;
+}
+
+}
+
+/**
+ * @brief The classic spawner: the default WaveSpec alone
+ */
+SpawnTable classicSpawnTable() {
+    return SpawnTable{ WaveSpec() };
+}
+
+/**
+ * @brief Stress table: the classic trickle plus waves that ramp up to thousands of enemies
+ */
+SpawnTable siegeSpawnTable() {
+    SpawnTable table = classicSpawnTable();
+
+    // Blobs from every edge, half again as many each wave: about 30 enemies
+    // in the first wave, over 3000 from the thirteenth on
+    WaveSpec swarm;
+    swarm.start = 300;
+    swarm.every = 300;
+    swarm.groups = 8;
+    swarm.ramp = RampCurve::EXPONENTIAL;
+    swarm.rampStep = 50;
+    swarm.maxGroups = 1024;
+    swarm.followPercent = 100;
+    swarm.followersMin = 2;
+    swarm.followersMax = 4;
+    swarm.sameKindPercent = 70;
+    swarm.spread = 4;
+    table.push_back(swarm);
+
+    // Lines of bombermen from the left and right edges to break walls
+    WaveSpec breakers;
+    breakers.start = 450;
+    breakers.every = 600;
+    breakers.groups = 2;
+    breakers.ramp = RampCurve::LINEAR;
+    breakers.rampStep = 2;
+    breakers.edges = EDGE_LEFT | EDGE_RIGHT;
+    breakers.shape = ClusterShape::LINE;
+    breakers.raiderPercent = 0;
+    breakers.followPercent = 100;
+    breakers.followersMin = 6;
+    breakers.followersMax = 10;
+    breakers.sameKindPercent = 100;
+    table.push_back(breakers);
+    return table;
+}
+
+/**
+ * @brief A row as one line of the spawn table text format
+ */
+std::string formatWave(const WaveSpec& spec) {
+    std::string edges;
+    for (int e = 0; e < 4; ++e) {
+        if (spec.edges & (1 << e)) edges += EDGE_LETTERS[e];
+    }
+    char line[320];
+    snprintf(line, sizeof(line),
+             "wave start=%u every=%u waves=%u groups=%u ramp=%s step=%u max=%u raiders=%u edges=%s"
+             " shape=%s follow=%u followers=%u-%u same=%u spread=%u",
+             spec.start, spec.every, spec.waves, spec.groups,
+             nameOf(RAMP_NAMES, RAMP_COUNT, static_cast<int>(spec.ramp)), spec.rampStep, spec.maxGroups,
+             spec.raiderPercent, edges.c_str(), nameOf(SHAPE_NAMES, SHAPE_COUNT, static_cast<int>(spec.shape)),
+             spec.followPercent, spec.followersMin, spec.followersMax, spec.sameKindPercent, spec.spread);
+    return line;
+}
+
+/**
+ * @brief Parse a line written by formatWave()
+ */
+bool parseWave(const std::string& line, WaveSpec& spec, std::string* error) {
+    std::istringstream words(line);
+    std::string word;
+    if (!(words >> word) || word != "wave") {
+        if (error) *error = "expected a line starting with \"wave\"";
+        return false;
+    }
+
+    WaveSpec parsed;
+    while (words >> word) {
+        size_t equals = word.find('=');
+        if (equals == std::string::npos || !parseField(word.substr(0, equals), word.substr(equals + 1), parsed)) {
+            if (error) *error = "bad wave field \"" + word + "\"";
+            return false;
+        }
+    }
+    spec = parsed;
+    return true;
+}
+
+/**
+ * @brief Check that a row holds only values parseWave() can produce
+ */
+bool isValidWave(const WaveSpec& spec) {
+    return static_cast<int>(spec.ramp) < RAMP_COUNT && static_cast<int>(spec.shape) < SHAPE_COUNT &&
+           spec.maxGroups <= MAX_WAVE_GROUPS && spec.edges != 0 && spec.edges <= EDGE_ALL &&
+           spec.raiderPercent <= 100 && spec.followPercent <= 100 && spec.sameKindPercent <= 100 &&
+           spec.followersMin <= spec.followersMax;
+}
+
+/**
+ * @brief Load a spawn table by preset name ("classic", "siege") or from a file
+ */
+bool loadSpawnTable(const std::string& source, SpawnTable& table, std::string* error) {
+    if (source == "classic") {
+        table = classicSpawnTable();
+        return true;
+    }
+    if (source == "siege") {
+        table = siegeSpawnTable();
+        return true;
+    }
+
+    std::ifstream file(source);
+    if (!file) {
+        if (error) *error = strerror(errno);
+        return false;
+    }
+    SpawnTable rows;
+    std::string line, problem;
+    for (int lineNumber = 1; std::getline(file, line); ++lineNumber) {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') continue;
+        WaveSpec spec;
+        if (!parseWave(line, spec, &problem)) {
+            if (error) *error = "line " + std::to_string(lineNumber) + ": " + problem;
+            return false;
+        }
+        rows.push_back(spec);
+    }
+    table = rows;
+    return true;
+}
+
+void WaveBatch::clear() {
+    for (int k = 0; k < EnemyKinds::size; ++k) {
+        positions[k].clear();
+        order[k].clear();
+    }
+    size = 0;
+}
+
+WaveScheduler::WaveScheduler(SpawnTable table) : table(std::move(table)) {}
+
+/**
+ * @brief Number of groups in wave n (0-based) of a row, after ramp and cap
+ *
+ * Exponential growth is applied one wave at a time in integers, so every
+ * platform agrees; it stops at the cap, or for good once a wave is too
+ * small for the percentage to add a whole group.
+ */
+uint32_t WaveScheduler::groupsInWave(const WaveSpec& spec, uint64_t wave) {
+    uint64_t cap = spec.maxGroups > 0 ? std::min(spec.maxGroups, MAX_WAVE_GROUPS) : MAX_WAVE_GROUPS;
+    uint64_t groups = spec.groups;
+    switch (spec.ramp) {
+        case RampCurve::LINEAR:
+            // Past wave cap the cap is reached whatever the step, so the product cannot overflow
+            groups += static_cast<uint64_t>(spec.rampStep) * std::min(wave, cap);
+            break;
+        case RampCurve::EXPONENTIAL:
+            for (uint64_t w = 0; w < wave && groups < cap; ++w) {
+                uint64_t next = groups * (100 + spec.rampStep) / 100;
+                if (next == groups) break;
+                groups = next;
+            }
+            break;
+        default:
+            break;
+    }
+    return static_cast<uint32_t>(std::min(groups, cap));
+}
+
+/**
+ * @brief Generate the enemies of every wave due when a tick completes
+ */
+const WaveBatch& WaveScheduler::spawnDue(uint64_t completed, RngStream random, const SpawnArea& area) {
+    batch.clear();
+    for (const WaveSpec& spec : table) {
+        if (completed < spec.start) continue;
+        uint64_t since = completed - spec.start;
+        if (spec.every == 0 ? since != 0 : since % spec.every != 0) continue;
+        uint64_t wave = spec.every == 0 ? 0 : since / spec.every;
+        if (spec.waves > 0 && wave >= spec.waves) continue;
+        generate(spec, groupsInWave(spec, wave), random, area);
+    }
+    return batch;
+}
+
+/**
+ * @brief Place the groups of one wave
+ *
+ * Draw order per group: edge, point on the edge, leader kind, follow roll,
+ * follower count, then per follower its offsets (BLOB only) and kind.
+ * With the default row this is exactly the draw sequence of the original
+ * single-enemy spawner, so classic games play out as before.
+ */
+void WaveScheduler::generate(const WaveSpec& spec, uint32_t groups, RngStream& random, const SpawnArea& area) {
+    int edges[4];
+    int edgeCount = 0;
+    for (int e = 0; e < 4; ++e) {
+        if (spec.edges & (1 << e)) edges[edgeCount++] = e;
+    }
+    if (edgeCount == 0 || groups == 0) return;
+
+    // Room for the largest possible wave, so the loop below never reallocates
+    size_t most = static_cast<size_t>(groups) * (1 + spec.followersMax);
+    for (int k = 0; k < EnemyKinds::size; ++k) {
+        batch.positions[k].reserve(batch.positions[k].size() + most);
+        batch.order[k].reserve(batch.order[k].size() + most);
+    }
+
+    auto place = [&](UnitKind kind, int x, int y) {
+        int k = EnemyKinds::indexOf(kind);
+        batch.positions[k].push_back(Position(std::min(std::max(x, area.left), area.right),
+                                              std::min(std::max(y, area.top), area.bottom)));
+        batch.order[k].push_back(batch.size++);
+    };
+
+    for (uint32_t g = 0; g < groups; ++g) {
+        // 0=top, 1=right, 2=bottom, 3=left
+        int edge = edges[random.uniform(0, edgeCount - 1)];
+        int x, y;
+        switch (edge) {
+            case 0: x = random.uniform(area.left, area.right); y = area.top; break;
+            case 1: x = area.right; y = random.uniform(area.top, area.bottom); break;
+            case 2: x = random.uniform(area.left, area.right); y = area.bottom; break;
+            default: x = area.left; y = random.uniform(area.top, area.bottom); break;
+        }
+
+        bool raider = random.uniform(0, 99) < spec.raiderPercent;
+        UnitKind leader = raider ? UnitKind::RAIDER : UnitKind::BOMBERMAN;
+        UnitKind other = raider ? UnitKind::BOMBERMAN : UnitKind::RAIDER;
+        place(leader, x, y);
+
+        if (random.uniform(0, 99) >= spec.followPercent) continue;
+        int followers = random.uniform(spec.followersMin, spec.followersMax);
+        bool alongX = edge == 0 || edge == 2;
+        int inward = edge == 0 || edge == 3 ? 1 : -1;
+        for (int i = 0; i < followers; ++i) {
+            int fx = x, fy = y;
+            switch (spec.shape) {
+                case ClusterShape::BLOB:
+                    fx += random.uniform(-spec.spread, spec.spread);
+                    fy += random.uniform(-spec.spread, spec.spread);
+                    break;
+                case ClusterShape::LINE: {
+                    int offset = (i / 2 + 1) * (i % 2 ? -1 : 1);
+                    (alongX ? fx : fy) += offset;
+                    break;
+                }
+                case ClusterShape::COLUMN:
+                    (alongX ? fy : fx) += inward * (i + 1);
+                    break;
+            }
+            place(random.uniform(0, 99) < spec.sameKindPercent ? leader : other, fx, fy);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/**
+ * @file World.cpp
+ * @brief Implementation of the headless fixed-tick simulation driver
+ */
+
+#include "World.h"
+#include <utility>
+
+World::World(uint64_t seed, int threads, MapSize size, SpawnTable spawnTable)
+    : board(seed, threads, size, std::move(spawnTable)) {}
+
+/**
+ * @brief Advance the simulation by a number of fixed ticks
+ *
+ * @param n Number of ticks to run
+ * @return Number of ticks actually simulated
+ */
+int World::step(int n) {
+    int ran = 0;
+    while (ran < n && !board.isGameOver()) {
+        board.update();
+        ++ran;
+    }
+    return ran;
+}
+
+/**
+ * @brief Apply a single player command
+ *
+ * @param command Command character (U/D/L/R/W/M/E/C/A/B)
+ * @return true if the command was recognized and succeeded
+ */
+bool World::handleCommand(char command) {
+    switch (command) {
+        case 'U': case 'D': case 'L': case 'R':
+            return board.tryMovePlayer(command);
+        case 'W':
+            return board.placeWall();
+        case 'M':
+            return board.placeGoldMine();
+        case 'E':
+            return board.placeElixirCollector();
+        case 'C':
+            board.collectResources();
+            return true;
+        case 'A':
+            return board.trainArcher();
+        case 'B':
+            return board.trainBarbarian();
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief 64-bit FNV-1a hash of the snapshot of the current state
+ */
+uint64_t World::digest() const {
+    std::string state;
+    board.writeSnapshot(state);
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char byte : state) {
+        hash ^= byte;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
@@ -1,48 +1,176 @@
-#include "Board.h"
+#include "World.h"
+#include "TerminalRenderer.h"
 #include "InputManager.h"
-#include <unistd.h>  
+#include "TickTimer.h"
+#include "Profiler.h"
+#include "Recording.h"
+#include "ObserverServer.h"
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
 #include <iostream>
+#include <cstdlib>
+#include <random>
+#include <vector>
 using namespace std;
 
-int main() {
-    cout << "\033[?25l";
-    Board board;
+namespace {
+// Simulation tick period unless VILLAGE_TICK_MS overrides it
+const int DEFAULT_TICK_MS = 100;
+
+// Minimum time between two frames; changes in between are batched
+const chrono::milliseconds FRAME_INTERVAL(16);
+
+// Ticks run at most per wake-up, so a stall does not turn into a long catch-up
+const uint64_t MAX_CATCH_UP_TICKS = 5;
+
+// Screen size for the viewport: the terminal (one row left for the cursor)
+// but no larger than the map
+void screenSize(const Board& board, int& columns, int& rows) {
+    columns = board.getWidth();
+    rows = board.getHeight();
+    winsize ws{};
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) != 0 || ws.ws_col == 0 || ws.ws_row == 0) return;
+    columns = min(columns, max<int>(ws.ws_col, board.getMargin() + 20));
+    rows = min(rows, max<int>(ws.ws_row - 1, MapSize::MIN_HEIGHT));
+}
+}
+
+int main(int argc, char* argv[]) {
+    // An explicit seed replays the same game; otherwise every run differs
+    uint64_t seed = argc > 1 ? strtoull(argv[1], nullptr, 0) : random_device{}();
+    int tickMs = DEFAULT_TICK_MS;
+    if (const char* value = getenv("VILLAGE_TICK_MS")) {
+        if (atoi(value) > 0) tickMs = atoi(value);
+    }
+
+    // VILLAGE_MAP=<width>x<height> plays on a larger map through a scrolling viewport
+    MapSize mapSize;
+    if (const char* value = getenv("VILLAGE_MAP")) {
+        if (!MapSize::parse(value, mapSize)) {
+            cerr << "VILLAGE_MAP must look like 1024x512" << endl;
+            return 1;
+        }
+    }
+
+    // VILLAGE_WAVES=classic|siege|<file> picks the enemy spawn table
+    SpawnTable spawnTable = classicSpawnTable();
+    if (const char* value = getenv("VILLAGE_WAVES")) {
+        string error;
+        if (!loadSpawnTable(value, spawnTable, &error)) {
+            cerr << "VILLAGE_WAVES: " << value << ": " << error << endl;
+            return 1;
+        }
+    }
+
+    cout << "\033[?25l" << flush;
+    World world(seed, 0, mapSize, spawnTable);
+    int columns, rows;
+    screenSize(world.getBoard(), columns, rows);
+    TerminalRenderer renderer(columns, rows);
     InputManager inputManager;
+    TickTimer ticks(tickMs);
+
+    // VILLAGE_RECORD=<file> saves the seed and every command for village_replay
+    const char* recordPath = getenv("VILLAGE_RECORD");
+    Recording recording(seed, world.getBoard().getSize(), world.getBoard().getSpawnTable());
+    auto start = chrono::steady_clock::now();
+
+    // VILLAGE_OBSERVE=<socket> publishes the game to village_watch observers
+    ObserverServer observers;
+    if (const char* observePath = getenv("VILLAGE_OBSERVE")) {
+        string error;
+        if (!observers.listen(observePath, &error)) {
+            cout << "\033[?25h";
+            cerr << "VILLAGE_OBSERVE: " << observePath << ": " << error << endl;
+            return 1;
+        }
+    }
+
+    // One poll() waits for keys, the tick timer and the next frame deadline;
+    // nothing runs while the game is idle between ticks
+    vector<char> commands;
+    bool quit = false;
+    bool dirty = true;
+    auto nextFrame = chrono::steady_clock::now();
+    while (!quit) {
+        auto now = chrono::steady_clock::now();
+        if (dirty && now >= nextFrame) {
+            renderer.render(world.getBoard());
+            dirty = false;
+            nextFrame = now + FRAME_INTERVAL;
+            if (world.isGameOver()) break;
+        }
+
+        pollfd fds[3] = {
+            { inputManager.fd(), POLLIN, 0 },
+            { observers.fd(), POLLIN, 0 },
+            { ticks.fd(), POLLIN, 0 },
+        };
+        int timeout = -1;
+        if (dirty) {
+            timeout = static_cast<int>(chrono::duration_cast<chrono::milliseconds>(nextFrame - now).count());
+            if (timeout < 0) timeout = 0;
+        }
+        if (ticks.fd() < 0 && (timeout < 0 || ticks.msUntilDue() < timeout)) timeout = ticks.msUntilDue();
+
+        if (poll(fds, ticks.fd() >= 0 ? 3 : 2, timeout) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
 
-    while (true) {
-        board.render();
-        char input = inputManager.getInput();
-
-        switch(input) {
-            case 'U': case 'D': case 'L': case 'R':
-                board.tryMovePlayer(input);
-                board.update();
-                break;
-            case 'W':
-                board.placeWall();
-                break;
-            case 'M':
-                board.placeGoldMine();
-                break;
-            case 'E':
-                board.placeElixirCollector();
-                break;
-            case 'C':
-                board.collectResources();
-                break;
-                            case 'A':
-                board.trainArcher();
-                break;
-                            case 'B':
-                board.trainBarbarian();
-                break;
-            case 'Q':
-                cout << "\033[?25h";
-                return 0;
-        }
-
-        usleep(1000);
+        if (fds[1].revents & POLLIN) observers.acceptClients();
+
+        // Every key that arrived is applied before the next frame
+        if (fds[0].revents & (POLLIN | POLLHUP | POLLERR)) {
+            bool changed = false;
+            commands.clear();
+            if (!inputManager.readCommands(commands)) quit = true;
+            for (char command : commands) {
+                switch (command) {
+                    case 'P':
+                        renderer.toggleProfile();
+                        break;
+                    case 'Q':
+                        quit = true;
+                        break;
+                    default:
+                        if (recordPath) {
+                            auto ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+                            recording.add(world.getTick(), static_cast<uint64_t>(ms.count()), command);
+                        }
+                        world.handleCommand(command);
+                        changed = true;
+                        break;
+                }
+                dirty = true;
+            }
+            if (changed && observers.fd() >= 0) observers.publish(world.getBoard());
+        }
+
+        // Observers get one delta per tick, so a catch-up is stepped a tick at a time
+        uint64_t due = ticks.takeDue();
+        if (due > 0) {
+            uint64_t run = due < MAX_CATCH_UP_TICKS ? due : MAX_CATCH_UP_TICKS;
+            for (uint64_t t = 0; t < run && world.step(1) == 1; ++t) {
+                if (observers.fd() >= 0) observers.publish(world.getBoard());
+            }
+            dirty = true;
+        }
     }
     cout << "\033[?25h";
+
+    if (recordPath) {
+        recording.finish(world.getTick(), world.digest());
+        if (!recording.save(recordPath)) cerr << "Could not write recording to " << recordPath << endl;
+    }
+
+    // VILLAGE_PROFILE=<file> saves the profiler summary on exit
+    if (const char* profilePath = getenv("VILLAGE_PROFILE")) {
+        if (!Profiler::dump(profilePath)) cerr << "Could not write profile to " << profilePath << endl;
+    }
     return 0;
 }